@@ -0,0 +1,47 @@
+# Copyright (c) 2021 R. Tohid (@rtohid)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Compare the batched GEMM primitive of the Halide plugin against numpy.
+
+from phylanx import Phylanx, PhylanxSession
+import numpy as np
+
+PhylanxSession.init(16)
+
+np.random.seed(42)
+
+# the number of matrices and their sizes are not multiples of the blocks of
+# the kernel
+P = 7
+M = 13
+N = 11
+K = 9
+
+
+def check(name, result, expected):
+    ok = np.allclose(result, expected, rtol=1e-12, atol=1e-12)
+    print(name, 'ok' if ok else 'FAILED')
+    assert ok
+
+
+# transpose every page of a stack of matrices
+def op(A, trans):
+    return np.swapaxes(A, 1, 2) if trans else A
+
+
+@Phylanx
+def dgemm_batched_halide(is_a_trans, is_b_trans, a, A, B, b, C):
+    return dgemm_batched(is_a_trans, is_b_trans, a, A, B, b, C)
+
+
+C = np.random.rand(P, M, N) - 0.5
+for trans_a in [False, True]:
+    for trans_b in [False, True]:
+        A = np.random.rand(*((P, K, M) if trans_a else (P, M, K))) - 0.5
+        B = np.random.rand(*((P, N, K) if trans_b else (P, K, N))) - 0.5
+        check('dgemm_batched trans_a=%s trans_b=%s' % (trans_a, trans_b),
+              dgemm_batched_halide(trans_a, trans_b, 2.0, A, B, -0.5,
+                                   C.copy()),
+              2.0 * np.matmul(op(A, trans_a), op(B, trans_b)) - 0.5 * C)
@@ -0,0 +1,136 @@
+# Copyright (c) 2021 R. Tohid (@rtohid)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Compare the Level-1 BLAS primitives of the Halide plugin against numpy.
+
+from phylanx import Phylanx, PhylanxSession
+import numpy as np
+
+PhylanxSession.init(16)
+
+np.random.seed(42)
+
+N = 1031
+
+
+def check(name, result, expected):
+    ok = np.allclose(result, expected, rtol=1e-12, atol=1e-12)
+    print(name, 'ok' if ok else 'FAILED')
+    assert ok
+
+
+@Phylanx
+def dnrm2_halide(N, x, incX):
+    return dnrm2(N, x, incX)
+
+
+x = np.random.rand(N) - 0.5
+check('dnrm2', dnrm2_halide(N, x, 1), np.linalg.norm(x))
+check('dnrm2 incX=3', dnrm2_halide(N // 3, x, 3),
+      np.linalg.norm(x[::3][:N // 3]))
+
+# the squares of these overflow or underflow, the norm does not
+for scale in [1e200, 1e-200]:
+    x = scale * (np.random.rand(N) - 0.5)
+    result = dnrm2_halide(N, x, 1)
+    expected = scale * np.linalg.norm(x / scale)
+    ok = np.isclose(result, expected, rtol=1e-12, atol=0)
+    print('dnrm2 scale', scale, 'ok' if ok else 'FAILED')
+    assert ok
+
+
+@Phylanx
+def idamax_halide(N, x, incX):
+    return idamax(N, x, incX)
+
+
+x = np.random.rand(N) - 0.5
+x[N // 2] = -2
+x[N - 3] = 2
+check('idamax', idamax_halide(N, x, 1), np.argmax(np.abs(x)))
+check('idamax incX=2', idamax_halide(N // 2, x, 2),
+      np.argmax(np.abs(x[::2][:N // 2])))
+
+
+@Phylanx
+def dswap_halide(x, y):
+    return dswap(x, y)
+
+
+x = np.random.rand(N)
+y = np.random.rand(N)
+result = dswap_halide(x, y)
+check('dswap x', result[0], y)
+check('dswap y', result[1], x)
+
+
+@Phylanx
+def daxpby_halide(a, x, b, y):
+    return daxpby(a, x, b, y)
+
+
+check('daxpby', daxpby_halide(2.5, x, -0.5, y), 2.5 * x - 0.5 * y)
+
+
+@Phylanx
+def drot_halide(x, y, c, s):
+    return drot(x, y, c, s)
+
+
+c, s = np.cos(0.3), np.sin(0.3)
+result = drot_halide(x, y, c, s)
+check('drot x', result[0], c * x + s * y)
+check('drot y', result[1], c * y - s * x)
+
+
+@Phylanx
+def drotm_halide(x, y, P):
+    return drotm(x, y, P)
+
+
+def rotm_matrix(P):
+    flag, h11, h21, h12, h22 = P
+    if flag == -1:
+        return np.array([[h11, h12], [h21, h22]])
+    if flag == 0:
+        return np.array([[1, h12], [h21, 1]])
+    if flag == 1:
+        return np.array([[h11, 1], [-1, h22]])
+    return np.eye(2)
+
+
+for flag in [-2, -1, 0, 1]:
+    P = np.array([flag, 0.5, -0.25, 0.75, 1.5])
+    H = rotm_matrix(P)
+    result = drotm_halide(x, y, P)
+    check('drotm flag=%d x' % flag, result[0], H[0, 0] * x + H[0, 1] * y)
+    check('drotm flag=%d y' % flag, result[1], H[1, 0] * x + H[1, 1] * y)
+
+
+@Phylanx
+def drotg_halide(a, b):
+    return drotg(a, b)
+
+
+for a, b in [(3.0, 4.0), (-4.0, 3.0), (1e-3, -2.0), (0.0, 0.0)]:
+    r, z, c, s = drotg_halide(a, b)
+    check('drotg (%g, %g)' % (a, b),
+          [c * a + s * b, c * b - s * a, c * c + s * s], [r, 0, 1])
+
+
+@Phylanx
+def drotmg_halide(d1, d2, b1, b2):
+    return drotmg(d1, d2, b1, b2)
+
+
+# H zeroes the second component and H**T * diag(d1', d2') * H = diag(d1, d2)
+for d1, d2, b1, b2 in [(2.0, 3.0, 1.0, 0.5), (1.0, 4.0, 0.25, 2.0),
+                       (1e-8, 1e8, 1.0, 1.0), (1.0, 1.0, 1.0, 0.0)]:
+    r1, r2, rb1, P = drotmg_halide(d1, d2, b1, b2)
+    H = rotm_matrix(P)
+    check('drotmg (%g, %g, %g, %g)' % (d1, d2, b1, b2),
+          np.concatenate([H.dot([b1, b2]),
+                          H.T.dot(np.diag([r1, r2])).dot(H).ravel()]),
+          np.concatenate([[rb1, 0], np.diag([d1, d2]).ravel()]))
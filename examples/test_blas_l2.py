@@ -0,0 +1,116 @@
+# Copyright (c) 2021 R. Tohid (@rtohid)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Compare the Level-2 BLAS primitives of the Halide plugin against numpy. The
+# matrices are not symmetric (triangular), the primitives must not touch the
+# other triangle.
+
+from phylanx import Phylanx, PhylanxSession
+import numpy as np
+
+PhylanxSession.init(16)
+
+np.random.seed(42)
+
+N = 131
+
+
+def check(name, result, expected):
+    ok = np.allclose(result, expected, rtol=1e-10, atol=1e-10)
+    print(name, 'ok' if ok else 'FAILED')
+    assert ok
+
+
+def triangle(A, lower):
+    return np.tril(A) if lower else np.triu(A)
+
+
+def symmetric(A, lower):
+    T = triangle(A, lower)
+    return T + T.T - np.diag(np.diag(A))
+
+
+def triangular(A, lower, unit):
+    T = triangle(A, lower)
+    if unit:
+        np.fill_diagonal(T, 1)
+    return T
+
+
+# A with the given triangle taken from U
+def update(A, U, lower):
+    mask = np.tril(np.ones(A.shape, dtype=bool)) if lower else \
+        np.triu(np.ones(A.shape, dtype=bool))
+    return np.where(mask, U, A)
+
+
+A = np.random.rand(N, N) - 0.5
+x = np.random.rand(N) - 0.5
+y = np.random.rand(N) - 0.5
+
+# well conditioned triangular matrices for the solvers
+T = A / N + 2 * np.eye(N)
+
+
+@Phylanx
+def dsymv_halide(is_lower, a, A, x, b, y):
+    return dsymv(is_lower, a, A, x, b, y)
+
+
+for lower in [False, True]:
+    check('dsymv lower=%s' % lower,
+          dsymv_halide(lower, 2.0, A, x, -0.5, y),
+          2.0 * symmetric(A, lower).dot(x) - 0.5 * y)
+
+
+@Phylanx
+def dsyr_halide(is_lower, a, x, A):
+    return dsyr(is_lower, a, x, A)
+
+
+for lower in [False, True]:
+    check('dsyr lower=%s' % lower,
+          dsyr_halide(lower, 2.0, x, A.copy()),
+          update(A, A + 2.0 * np.outer(x, x), lower))
+
+
+@Phylanx
+def dsyr2_halide(is_lower, a, x, y, A):
+    return dsyr2(is_lower, a, x, y, A)
+
+
+for lower in [False, True]:
+    check('dsyr2 lower=%s' % lower,
+          dsyr2_halide(lower, 2.0, x, y, A.copy()),
+          update(A, A + 2.0 * (np.outer(x, y) + np.outer(y, x)), lower))
+
+
+@Phylanx
+def dtrmv_halide(is_lower, is_trans, is_unit, A, x):
+    return dtrmv(is_lower, is_trans, is_unit, A, x)
+
+
+@Phylanx
+def dtrsv_halide(is_lower, is_trans, is_unit, A, b):
+    return dtrsv(is_lower, is_trans, is_unit, A, b)
+
+
+for lower in [False, True]:
+    for trans in [False, True]:
+        for unit in [False, True]:
+            flags = 'lower=%s trans=%s unit=%s' % (lower, trans, unit)
+
+            op_A = triangular(A, lower, unit)
+            if trans:
+                op_A = op_A.T
+            check('dtrmv ' + flags,
+                  dtrmv_halide(lower, trans, unit, A, x.copy()), op_A.dot(x))
+
+            op_T = triangular(T, lower, unit)
+            if trans:
+                op_T = op_T.T
+            check('dtrsv ' + flags,
+                  dtrsv_halide(lower, trans, unit, T, x.copy()),
+                  np.linalg.solve(op_T, x))
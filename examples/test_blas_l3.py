@@ -0,0 +1,154 @@
+# Copyright (c) 2021 R. Tohid (@rtohid)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Compare the Level-3 BLAS primitives of the Halide plugin against numpy. The
+# sizes are larger than the blocks of the drivers (256) and not multiples of
+# the vector width, the matrices are not symmetric (triangular), the
+# primitives must not touch the other triangle.
+
+from phylanx import Phylanx, PhylanxSession
+import numpy as np
+
+PhylanxSession.init(16)
+
+np.random.seed(42)
+
+M = 301
+N = 283
+K = 267
+
+
+def check(name, result, expected):
+    ok = np.allclose(result, expected, rtol=1e-10, atol=1e-10)
+    print(name, 'ok' if ok else 'FAILED')
+    assert ok
+
+
+def triangle(A, lower):
+    return np.tril(A) if lower else np.triu(A)
+
+
+def symmetric(A, lower):
+    T = triangle(A, lower)
+    return T + T.T - np.diag(np.diag(A))
+
+
+def triangular(A, lower, unit):
+    T = triangle(A, lower)
+    if unit:
+        np.fill_diagonal(T, 1)
+    return T
+
+
+# C with the given triangle taken from U
+def update(C, U, lower):
+    mask = np.tril(np.ones(C.shape, dtype=bool)) if lower else \
+        np.triu(np.ones(C.shape, dtype=bool))
+    return np.where(mask, U, C)
+
+
+def op(A, trans):
+    return A.T if trans else A
+
+
+@Phylanx
+def dgemm_halide(is_a_trans, is_b_trans, a, A, B, b, C):
+    return dgemm(is_a_trans, is_b_trans, a, A, B, b, C)
+
+
+C = np.random.rand(M, N) - 0.5
+for trans_a in [False, True]:
+    for trans_b in [False, True]:
+        A = np.random.rand(*op(np.empty((M, K)), trans_a).shape) - 0.5
+        B = np.random.rand(*op(np.empty((K, N)), trans_b).shape) - 0.5
+        check('dgemm trans_a=%s trans_b=%s' % (trans_a, trans_b),
+              dgemm_halide(trans_a, trans_b, 2.0, A, B, -0.5, C.copy()),
+              2.0 * op(A, trans_a).dot(op(B, trans_b)) - 0.5 * C)
+
+
+@Phylanx
+def dsyrk_halide(is_lower, is_trans, a, A, b, C):
+    return dsyrk(is_lower, is_trans, a, A, b, C)
+
+
+@Phylanx
+def dsyr2k_halide(is_lower, is_trans, a, A, B, b, C):
+    return dsyr2k(is_lower, is_trans, a, A, B, b, C)
+
+
+C = np.random.rand(N, N) - 0.5
+for lower in [False, True]:
+    for trans in [False, True]:
+        flags = 'lower=%s trans=%s' % (lower, trans)
+
+        # op(A) and op(B) are N x K
+        A = np.random.rand(*op(np.empty((N, K)), trans).shape) - 0.5
+        B = np.random.rand(*A.shape) - 0.5
+        op_A = op(A, trans)
+        op_B = op(B, trans)
+
+        check('dsyrk ' + flags,
+              dsyrk_halide(lower, trans, 2.0, A, -0.5, C.copy()),
+              update(C, 2.0 * op_A.dot(op_A.T) - 0.5 * C, lower))
+
+        check('dsyr2k ' + flags,
+              dsyr2k_halide(lower, trans, 2.0, A, B, -0.5, C.copy()),
+              update(C, 2.0 * (op_A.dot(op_B.T) + op_B.dot(op_A.T)) -
+                     0.5 * C, lower))
+
+
+@Phylanx
+def dsymm_halide(is_right, is_lower, a, A, B, b, C):
+    return dsymm(is_right, is_lower, a, A, B, b, C)
+
+
+B = np.random.rand(M, N) - 0.5
+C = np.random.rand(M, N) - 0.5
+for right in [False, True]:
+    for lower in [False, True]:
+        A = np.random.rand(*((N, N) if right else (M, M))) - 0.5
+        S = symmetric(A, lower)
+        check('dsymm right=%s lower=%s' % (right, lower),
+              dsymm_halide(right, lower, 2.0, A, B, -0.5, C.copy()),
+              2.0 * (B.dot(S) if right else S.dot(B)) - 0.5 * C)
+
+
+@Phylanx
+def dtrmm_halide(is_right, is_lower, is_trans, is_unit, a, A, B):
+    return dtrmm(is_right, is_lower, is_trans, is_unit, a, A, B)
+
+
+@Phylanx
+def dtrsm_halide(is_right, is_lower, is_trans, is_unit, a, A, B):
+    return dtrsm(is_right, is_lower, is_trans, is_unit, a, A, B)
+
+
+for right in [False, True]:
+    size = N if right else M
+    A = np.random.rand(size, size) - 0.5
+
+    # well conditioned triangular matrices for the solver
+    T = A / size + 2 * np.eye(size)
+
+    for lower in [False, True]:
+        for trans in [False, True]:
+            for unit in [False, True]:
+                flags = 'right=%s lower=%s trans=%s unit=%s' % (
+                    right, lower, trans, unit)
+
+                op_A = op(triangular(A, lower, unit), trans)
+                check('dtrmm ' + flags,
+                      dtrmm_halide(right, lower, trans, unit, 2.0, A,
+                                   B.copy()),
+                      2.0 * (B.dot(op_A) if right else op_A.dot(B)))
+
+                # X * op(T) = a * B is op(T)**T * X**T = a * B**T
+                op_T = op(triangular(T, lower, unit), trans)
+                expected = np.linalg.solve(op_T.T, 2.0 * B.T).T if right \
+                    else np.linalg.solve(op_T, 2.0 * B)
+                check('dtrsm ' + flags,
+                      dtrsm_halide(right, lower, trans, unit, 2.0, T,
+                                   B.copy()),
+                      expected)
@@ -8,7 +8,10 @@
 #include <Halide.h>
 
 #include "blas.hpp"
+#include "counters.hpp"
 #include "halide_blas.h"
+#include "launch_policy.hpp"
+#include "pipeline.hpp"
 
 #include <phylanx/config.hpp>
 
@@ -119,6 +122,259 @@ namespace phylanx_halide_plugin {
             Integer. Status.
         )";
 
+    constexpr char const* const idamax_string = R"(
+        N, x, incX
+        Args:
+            N (scalar): int
+            x (array): 1d
+            incX (scalar): int
+
+        Returns:
+
+            Integer. Index of the first element with the largest absolute
+            value.
+        )";
+
+    constexpr char const* const dswap_string = R"(
+        x, y
+        Args:
+            x (array): 1d
+            y (array): 1d
+
+        Returns:
+
+            List. The swapped vectors [x, y].
+        )";
+
+    constexpr char const* const daxpby_string = R"(
+        a, x, b, y
+        Args:
+            a (scalar): double
+            x (array): 1d
+            b (scalar): double
+            y (array): 1d
+
+        Returns:
+
+            Array. a * x + b * y.
+        )";
+
+    constexpr char const* const drot_string = R"(
+        x, y, c, s
+        Args:
+            x (array): 1d
+            y (array): 1d
+            c (scalar): double
+            s (scalar): double
+
+        Returns:
+
+            List. The rotated vectors [x, y].
+        )";
+
+    constexpr char const* const drotm_string = R"(
+        x, y, P
+        Args:
+            x (array): 1d
+            y (array): 1d
+            P (array): 1d, [flag, h11, h21, h12, h22]
+
+        Returns:
+
+            List. The transformed vectors [x, y].
+        )";
+
+    constexpr char const* const drotg_string = R"(
+        a, b
+        Args:
+            a (scalar): double
+            b (scalar): double
+
+        Returns:
+
+            List. [r, z, c, s] of the Givens rotation.
+        )";
+
+    constexpr char const* const drotmg_string = R"(
+        d1, d2, b1, b2
+        Args:
+            d1 (scalar): double
+            d2 (scalar): double
+            b1 (scalar): double
+            b2 (scalar): double
+
+        Returns:
+
+            List. [d1, d2, b1, P] of the modified Givens transformation.
+        )";
+
+    constexpr char const* const dsymv_string = R"(
+        is_lower, a, A, x, b, y
+        Args:
+            is_lower (bool) use the lower triangle of A?
+            a (scalar): double
+            A (array): 2d, symmetric
+            x (array): 1d
+            b (scalar): double
+            y (array): 1d
+
+        Returns:
+
+            Array. a * A * x + b * y.
+        )";
+
+    constexpr char const* const dsyr_string = R"(
+        is_lower, a, x, A
+        Args:
+            is_lower (bool) update the lower triangle of A?
+            a (scalar): double
+            x (array): 1d
+            A (array): 2d, symmetric
+
+        Returns:
+
+            Array. A with the triangle updated by a * x * x**T.
+        )";
+
+    constexpr char const* const dsyr2_string = R"(
+        is_lower, a, x, y, A
+        Args:
+            is_lower (bool) update the lower triangle of A?
+            a (scalar): double
+            x (array): 1d
+            y (array): 1d
+            A (array): 2d, symmetric
+
+        Returns:
+
+            Array. A with the triangle updated by a * (x * y**T + y * x**T).
+        )";
+
+    constexpr char const* const dtrmv_string = R"(
+        is_lower, is_trans, is_unit, A, x
+        Args:
+            is_lower (bool) A is lower triangular?
+            is_trans (bool) transpose A?
+            is_unit (bool) A has a unit diagonal?
+            A (array): 2d, triangular
+            x (array): 1d
+
+        Returns:
+
+            Array. op(A) * x.
+        )";
+
+    constexpr char const* const dtrsv_string = R"(
+        is_lower, is_trans, is_unit, A, b
+        Args:
+            is_lower (bool) A is lower triangular?
+            is_trans (bool) transpose A?
+            is_unit (bool) A has a unit diagonal?
+            A (array): 2d, triangular
+            b (array): 1d
+
+        Returns:
+
+            Array. The solution x of op(A) * x = b.
+        )";
+
+    constexpr char const* const dsyrk_string = R"(
+        is_lower, is_trans, a, A, b, C
+        Args:
+            is_lower (bool) update the lower triangle of C?
+            is_trans (bool) transpose A?
+            a (scalar): double
+            A (array): 2d
+            b (scalar): double
+            C (array): 2d, symmetric
+
+        Returns:
+
+            Array. C with the triangle updated to a * op(A) * op(A)**T + b * C.
+        )";
+
+    constexpr char const* const dsyr2k_string = R"(
+        is_lower, is_trans, a, A, B, b, C
+        Args:
+            is_lower (bool) update the lower triangle of C?
+            is_trans (bool) transpose A and B?
+            a (scalar): double
+            A (array): 2d
+            B (array): 2d
+            b (scalar): double
+            C (array): 2d, symmetric
+
+        Returns:
+
+            Array. C with the triangle updated to
+            a * (op(A) * op(B)**T + op(B) * op(A)**T) + b * C.
+        )";
+
+    constexpr char const* const dsymm_string = R"(
+        is_right, is_lower, a, A, B, b, C
+        Args:
+            is_right (bool) multiply by A from the right?
+            is_lower (bool) use the lower triangle of A?
+            a (scalar): double
+            A (array): 2d, symmetric
+            B (array): 2d
+            b (scalar): double
+            C (array): 2d
+
+        Returns:
+
+            Array. a * A * B + b * C, or a * B * A + b * C.
+        )";
+
+    constexpr char const* const dtrmm_string = R"(
+        is_right, is_lower, is_trans, is_unit, a, A, B
+        Args:
+            is_right (bool) multiply by A from the right?
+            is_lower (bool) A is lower triangular?
+            is_trans (bool) transpose A?
+            is_unit (bool) A has a unit diagonal?
+            a (scalar): double
+            A (array): 2d, triangular
+            B (array): 2d
+
+        Returns:
+
+            Array. a * op(A) * B, or a * B * op(A).
+        )";
+
+    constexpr char const* const dtrsm_string = R"(
+        is_right, is_lower, is_trans, is_unit, a, A, B
+        Args:
+            is_right (bool) solve for X * op(A)?
+            is_lower (bool) A is lower triangular?
+            is_trans (bool) transpose A?
+            is_unit (bool) A has a unit diagonal?
+            a (scalar): double
+            A (array): 2d, triangular
+            B (array): 2d
+
+        Returns:
+
+            Array. The solution X of op(A) * X = a * B, or X * op(A) = a * B.
+        )";
+
+    constexpr char const* const dgemm_batched_string = R"(
+        is_a_trans, is_b_trans, a, A, B, b, C
+        Args:
+            is_a_trans (bool) transpose the pages of A?
+            is_b_trans (bool) transpose the pages of B?
+            a (scalar): double
+            A (array): 3d, a stack of matrices
+            B (array): 3d, a stack of matrices
+            b (scalar): double
+            C (array): 3d, a stack of matrices
+
+        Returns:
+
+            Array. C with every page n updated to
+            a * op(A[n]) * op(B[n]) + b * C[n].
+        )";
+
     ///////////////////////////////////////////////////////////////////////////
     std::vector<phylanx::execution_tree::match_pattern_type> const
         blas::match_data = {
@@ -154,7 +410,101 @@ namespace phylanx_halide_plugin {
                 std::vector<std::string>{"dgemm(_1, _2, _3, _4, _5, _6, _7)"},
                 &create_dgemv_op,
                 &phylanx::execution_tree::create_primitive<blas>,
-                dgemm_string} };
+                dgemm_string},
+
+            phylanx::execution_tree::match_pattern_type{"idamax",
+                std::vector<std::string>{"idamax(_1, _2, _3)"}, &create_dscal_op,
+                &phylanx::execution_tree::create_primitive<blas>, idamax_string},
+
+            phylanx::execution_tree::match_pattern_type{"dswap",
+                std::vector<std::string>{"dswap(_1, _2)"}, &create_dscal_op,
+                &phylanx::execution_tree::create_primitive<blas>, dswap_string},
+
+            phylanx::execution_tree::match_pattern_type{"daxpby",
+                std::vector<std::string>{"daxpby(_1, _2, _3, _4)"}, &create_dscal_op,
+                &phylanx::execution_tree::create_primitive<blas>, daxpby_string},
+
+            phylanx::execution_tree::match_pattern_type{"drot",
+                std::vector<std::string>{"drot(_1, _2, _3, _4)"}, &create_dscal_op,
+                &phylanx::execution_tree::create_primitive<blas>, drot_string},
+
+            phylanx::execution_tree::match_pattern_type{"drotm",
+                std::vector<std::string>{"drotm(_1, _2, _3)"}, &create_dscal_op,
+                &phylanx::execution_tree::create_primitive<blas>, drotm_string},
+
+            phylanx::execution_tree::match_pattern_type{"drotg",
+                std::vector<std::string>{"drotg(_1, _2)"}, &create_dscal_op,
+                &phylanx::execution_tree::create_primitive<blas>, drotg_string},
+
+            phylanx::execution_tree::match_pattern_type{"drotmg",
+                std::vector<std::string>{"drotmg(_1, _2, _3, _4)"}, &create_dscal_op,
+                &phylanx::execution_tree::create_primitive<blas>, drotmg_string},
+
+            phylanx::execution_tree::match_pattern_type{"dsymv",
+                std::vector<std::string>{"dsymv(_1, _2, _3, _4, _5, _6)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dsymv_string},
+
+            phylanx::execution_tree::match_pattern_type{"dsyr",
+                std::vector<std::string>{"dsyr(_1, _2, _3, _4)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dsyr_string},
+
+            phylanx::execution_tree::match_pattern_type{"dsyr2",
+                std::vector<std::string>{"dsyr2(_1, _2, _3, _4, _5)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dsyr2_string},
+
+            phylanx::execution_tree::match_pattern_type{"dtrmv",
+                std::vector<std::string>{"dtrmv(_1, _2, _3, _4, _5)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dtrmv_string},
+
+            phylanx::execution_tree::match_pattern_type{"dtrsv",
+                std::vector<std::string>{"dtrsv(_1, _2, _3, _4, _5)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dtrsv_string},
+
+            phylanx::execution_tree::match_pattern_type{"dsyrk",
+                std::vector<std::string>{"dsyrk(_1, _2, _3, _4, _5, _6)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dsyrk_string},
+
+            phylanx::execution_tree::match_pattern_type{"dsyr2k",
+                std::vector<std::string>{"dsyr2k(_1, _2, _3, _4, _5, _6, _7)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dsyr2k_string},
+
+            phylanx::execution_tree::match_pattern_type{"dsymm",
+                std::vector<std::string>{"dsymm(_1, _2, _3, _4, _5, _6, _7)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dsymm_string},
+
+            phylanx::execution_tree::match_pattern_type{"dtrmm",
+                std::vector<std::string>{"dtrmm(_1, _2, _3, _4, _5, _6, _7)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dtrmm_string},
+
+            phylanx::execution_tree::match_pattern_type{"dtrsm",
+                std::vector<std::string>{"dtrsm(_1, _2, _3, _4, _5, _6, _7)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dtrsm_string},
+
+            phylanx::execution_tree::match_pattern_type{"dgemm_batched",
+                std::vector<std::string>{"dgemm_batched(_1, _2, _3, _4, _5, _6, _7)"},
+                &create_dgemv_op,
+                &phylanx::execution_tree::create_primitive<blas>,
+                dgemm_batched_string} };
 
     blas::blas_mode extract_blas_mode(std::string const& name)
     {
@@ -171,15 +521,72 @@ namespace phylanx_halide_plugin {
         else if (name.find("daxpy") != std::string::npos) {
             blas_op = blas::DAXPY;
         }
+        else if (name.find("daxpby") != std::string::npos) {
+            blas_op = blas::DAXPBY;
+        }
         else if (name.find("dgemv") != std::string::npos) {
             blas_op = blas::DGEMV;
         }
         else if (name.find("dger") != std::string::npos) {
             blas_op = blas::DGER;
         }
+        else if (name.find("dgemm_batched") != std::string::npos) {
+            blas_op = blas::DGEMM_BATCHED;
+        }
         else if (name.find("dgemm") != std::string::npos) {
             blas_op = blas::DGEMM;
         }
+        else if (name.find("idamax") != std::string::npos) {
+            blas_op = blas::IDAMAX;
+        }
+        else if (name.find("dswap") != std::string::npos) {
+            blas_op = blas::DSWAP;
+        }
+        // the names of the rotations are prefixes of each other, the longer
+        // ones have to be tested first
+        else if (name.find("drotmg") != std::string::npos) {
+            blas_op = blas::DROTMG;
+        }
+        else if (name.find("drotm") != std::string::npos) {
+            blas_op = blas::DROTM;
+        }
+        else if (name.find("drotg") != std::string::npos) {
+            blas_op = blas::DROTG;
+        }
+        else if (name.find("drot") != std::string::npos) {
+            blas_op = blas::DROT;
+        }
+        else if (name.find("dsymv") != std::string::npos) {
+            blas_op = blas::DSYMV;
+        }
+        // dsyr and dsyr2 are prefixes of the rank k updates
+        else if (name.find("dsyr2k") != std::string::npos) {
+            blas_op = blas::DSYR2K;
+        }
+        else if (name.find("dsyrk") != std::string::npos) {
+            blas_op = blas::DSYRK;
+        }
+        else if (name.find("dsyr2") != std::string::npos) {
+            blas_op = blas::DSYR2;
+        }
+        else if (name.find("dsyr") != std::string::npos) {
+            blas_op = blas::DSYR;
+        }
+        else if (name.find("dtrmv") != std::string::npos) {
+            blas_op = blas::DTRMV;
+        }
+        else if (name.find("dtrsv") != std::string::npos) {
+            blas_op = blas::DTRSV;
+        }
+        else if (name.find("dsymm") != std::string::npos) {
+            blas_op = blas::DSYMM;
+        }
+        else if (name.find("dtrmm") != std::string::npos) {
+            blas_op = blas::DTRMM;
+        }
+        else if (name.find("dtrsm") != std::string::npos) {
+            blas_op = blas::DTRSM;
+        }
         else {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 name,
@@ -194,6 +601,11 @@ namespace phylanx_halide_plugin {
             std::move(operands), name, codename)
         , mode_(extract_blas_mode(name_))
     {
+        for (auto const& pattern : match_data)
+        {
+            phylanx_halide_common::install_kernel_counters(
+                pattern.primitive_type_);
+        }
     }
 
     phylanx::execution_tree::primitive_argument_type blas::dscal(
@@ -204,6 +616,8 @@ namespace phylanx_halide_plugin {
         auto in_vector = x_value.vector();
         int in_size = in_vector.size();
         Buffer<double> x_buffer(in_vector.data(), in_size);
+        phylanx_halide_common::pipeline_scope scope("dscal");
+        phylanx_halide_common::kernel_timer timer("dscal", in_size, 16.0 * in_size);
         halide_dscal_impl(a_value, x_buffer, nullptr, x_buffer);
         return primitive_argument_type(std::move(x_value));
     }
@@ -219,6 +633,8 @@ namespace phylanx_halide_plugin {
         halide_dimension_t shape = { 0, n_value, inc_value };
         auto buff_x = Buffer<double>(x_vector.data(), 1, &shape);
         auto buff_sum = Buffer<double>::make_scalar(&result);
+        phylanx_halide_common::pipeline_scope scope("dasum");
+        phylanx_halide_common::kernel_timer timer("dasum", n_value, 8.0 * n_value);
         halide_dasum(buff_x, buff_sum);
 
         return primitive_argument_type(std::move(result));
@@ -235,9 +651,11 @@ namespace phylanx_halide_plugin {
         halide_dimension_t shape = { 0, n_value, inc_value };
         auto buff_x = Buffer<double>(x_vector.data(), 1, &shape);
         auto buff_nrm = Buffer<double>::make_scalar(&result);
-        halide_ddot(buff_x, buff_x, buff_nrm);
+        phylanx_halide_common::pipeline_scope scope("dnrm2");
+        phylanx_halide_common::kernel_timer timer("dnrm2", 2.0 * n_value, 8.0 * n_value);
+        halide_dnrm2(buff_x, buff_nrm);
 
-        return primitive_argument_type(std::sqrt(result));
+        return primitive_argument_type(std::move(result));
     }
 
     phylanx::execution_tree::primitive_argument_type blas::daxpy(
@@ -255,6 +673,8 @@ namespace phylanx_halide_plugin {
         int y_size = y_vector.size();
         Buffer<double> y_buffer(y_vector.data(), y_size);
 
+        phylanx_halide_common::pipeline_scope scope("daxpy");
+        phylanx_halide_common::kernel_timer timer("daxpy", 2.0 * x_size, 24.0 * x_size);
         halide_daxpy_impl(a_value, x_buffer, y_buffer, y_buffer);
 
 
@@ -287,6 +707,11 @@ namespace phylanx_halide_plugin {
         int y_size = y_vector.size();
         Buffer<double> y_buffer(y_vector.data(), y_size);
 
+        double const mn = double(vector_A.rows()) * vector_A.columns();
+
+        phylanx_halide_common::pipeline_scope scope("dgemv");
+        phylanx_halide_common::kernel_timer timer(
+            "dgemv", 2.0 * mn, 8.0 * (mn + x_size + 2 * y_size));
         halide_dgemv(is_transpose, a_value, A_buffer, x_buffer, b_value, y_buffer);
 
         return primitive_argument_type(std::move(y_value));
@@ -315,6 +740,10 @@ namespace phylanx_halide_plugin {
         auto vector_A = A_value.matrix();
         Buffer<double> A_buffer(vector_A.data(), vector_A.rows(), vector_A.columns());
 
+        phylanx_halide_common::pipeline_scope scope("dger");
+        double const mn = double(x_size) * y_size;
+        phylanx_halide_common::kernel_timer timer(
+            "dger", 2.0 * mn, 8.0 * (2 * mn + x_size + y_size));
         halide_dger(a_value, x_buffer, y_buffer, A_buffer);
 
         return primitive_argument_type(std::move(A_value));
@@ -344,174 +773,909 @@ namespace phylanx_halide_plugin {
         Buffer<double> B_buffer(vector_B.data(), vector_B.rows(), vector_B.columns());
         Buffer<double> C_buffer(vector_C.data(), vector_C.rows(), vector_C.columns());
 
+        // op(A) is m x k, op(B) is k x n
+        double const k = is_a ? vector_A.rows() : vector_A.columns();
+        double const mn = double(vector_C.rows()) * vector_C.columns();
+        double const elements = double(vector_A.rows()) * vector_A.columns() +
+            double(vector_B.rows()) * vector_B.columns() + 2 * mn;
+
+        phylanx_halide_common::pipeline_scope scope("dgemm");
+        phylanx_halide_common::kernel_timer timer(
+            "dgemm", 2.0 * mn * k, 8.0 * elements);
         halide_dgemm(is_a, is_b, a_value, A_buffer, B_buffer, b_value, C_buffer);
 
         return primitive_argument_type(std::move(C_value));
     }
 
-    ///////////////////////////////////////////////////////////////////////////
-    hpx::future<phylanx::execution_tree::primitive_argument_type> blas::eval(
-        primitive_arguments_type const& operands,
-        primitive_arguments_type const& args, eval_context ctx) const
+    phylanx::execution_tree::primitive_argument_type blas::idamax(
+        primitive_argument_type&& N, primitive_argument_type&& X, primitive_argument_type&& incX) const
     {
-        auto this_ = this->shared_from_this();
-        auto ctx_ = ctx;
-
-        if (2 == operands.size() && this_->mode_ == DSCAL)
-        {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& x)
-                ->primitive_argument_type {
-                return this_->dscal(a.get(), x.get());
-            },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx));
-        }
+        std::int32_t result;
+        int n_value = static_cast<int> (extract_scalar_numeric_value(std::move(N), name_, codename_));
+        int inc_value = static_cast<int> (extract_scalar_numeric_value(std::move(incX), name_, codename_));
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(X), name_, codename_);
+        auto x_vector = x_value.vector();
+        halide_dimension_t shape = { 0, n_value, inc_value };
+        auto buff_x = Buffer<double>(x_vector.data(), 1, &shape);
+        auto buff_max = Buffer<std::int32_t>::make_scalar(&result);
+        phylanx_halide_common::pipeline_scope scope("idamax");
+        phylanx_halide_common::kernel_timer timer("idamax", n_value, 8.0 * n_value);
+        halide_idamax(buff_x, buff_max);
 
-        if (3 == operands.size() && this_->mode_ == DASUM)
-        {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& N,
-                    hpx::future<primitive_argument_type>&& x,
-                    hpx::future<primitive_argument_type>&& incX)
-                ->primitive_argument_type {
-                return this_->dasum(N.get(), x.get(), incX.get());
-            },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx));
-        }
+        return primitive_argument_type(std::int64_t(result));
+    }
 
-        if (3 == operands.size() && this_->mode_ == DNRM2)
-        {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& N,
-                    hpx::future<primitive_argument_type>&& x,
-                    hpx::future<primitive_argument_type>&& incX)
-                ->primitive_argument_type {
-                return this_->dnrm2(N.get(), x.get(), incX.get());
-            },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx));
-        }
+    phylanx::execution_tree::primitive_argument_type blas::dswap(
+        primitive_argument_type&& x, primitive_argument_type&& y) const
+    {
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
 
-        if (3 == operands.size() && this_->mode_ == DAXPY)
-        {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& x,
-                    hpx::future<primitive_argument_type>&& y)
-                ->primitive_argument_type {
-                return this_->daxpy(a.get(), x.get(), y.get());
-            },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx));
-        }
+        auto y_value = phylanx::execution_tree::extract_numeric_value(std::move(y), name_, codename_);
+        auto y_vector = y_value.vector();
+        int y_size = y_vector.size();
+        Buffer<double> y_buffer(y_vector.data(), y_size);
 
+        phylanx_halide_common::pipeline_scope scope("dswap");
+        phylanx_halide_common::kernel_timer timer("dswap", 0.0, 32.0 * x_size);
+        halide_dswap(x_buffer, y_buffer);
 
-        if (6 == operands.size() && this_->mode_ == DGEMV)
-        {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& is_trans,
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& A,
-                    hpx::future<primitive_argument_type>&& x,
-                    hpx::future<primitive_argument_type>&& b,
-                    hpx::future<primitive_argument_type>&& y)
-                ->primitive_argument_type {
-                return this_->dgemv(is_trans.get(), a.get(), A.get(),
-                    x.get(), b.get(), y.get());
-            },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[3], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[4], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[5], args, name_, codename_, ctx));
-        }
+        return primitive_argument_type(primitive_arguments_type{
+            primitive_argument_type(std::move(x_value)),
+            primitive_argument_type(std::move(y_value))});
+    }
 
-        if (4 == operands.size() && this_->mode_ == DGER)
+    phylanx::execution_tree::primitive_argument_type blas::daxpby(
+        primitive_argument_type&& a, primitive_argument_type&& x,
+        primitive_argument_type&& b, primitive_argument_type&& y) const
+    {
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+        double b_value = extract_scalar_numeric_value(std::move(b), name_, codename_);
+
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
+
+        auto y_value = phylanx::execution_tree::extract_numeric_value(std::move(y), name_, codename_);
+        auto y_vector = y_value.vector();
+        int y_size = y_vector.size();
+        Buffer<double> y_buffer(y_vector.data(), y_size);
+
+        phylanx_halide_common::pipeline_scope scope("daxpby");
+        phylanx_halide_common::kernel_timer timer("daxpby", 3.0 * x_size, 24.0 * x_size);
+        halide_daxpby(a_value, x_buffer, b_value, y_buffer);
+
+        return primitive_argument_type(std::move(y_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::drot(
+        primitive_argument_type&& x, primitive_argument_type&& y,
+        primitive_argument_type&& c, primitive_argument_type&& s) const
+    {
+        double c_value = extract_scalar_numeric_value(std::move(c), name_, codename_);
+        double s_value = extract_scalar_numeric_value(std::move(s), name_, codename_);
+
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
+
+        auto y_value = phylanx::execution_tree::extract_numeric_value(std::move(y), name_, codename_);
+        auto y_vector = y_value.vector();
+        int y_size = y_vector.size();
+        Buffer<double> y_buffer(y_vector.data(), y_size);
+
+        phylanx_halide_common::pipeline_scope scope("drot");
+        phylanx_halide_common::kernel_timer timer("drot", 6.0 * x_size, 32.0 * x_size);
+        halide_drot(x_buffer, y_buffer, c_value, s_value);
+
+        return primitive_argument_type(primitive_arguments_type{
+            primitive_argument_type(std::move(x_value)),
+            primitive_argument_type(std::move(y_value))});
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::drotm(
+        primitive_argument_type&& x, primitive_argument_type&& y,
+        primitive_argument_type&& P) const
+    {
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
+
+        auto y_value = phylanx::execution_tree::extract_numeric_value(std::move(y), name_, codename_);
+        auto y_vector = y_value.vector();
+        int y_size = y_vector.size();
+        Buffer<double> y_buffer(y_vector.data(), y_size);
+
+        auto P_value = phylanx::execution_tree::extract_numeric_value(std::move(P), name_, codename_);
+        auto P_vector = P_value.vector();
+        if (P_vector.size() != 5)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "blas::drotm",
+                generate_error_message("P must have five elements."));
+        }
+
+        phylanx_halide_common::pipeline_scope scope("drotm");
+        phylanx_halide_common::kernel_timer timer("drotm", 6.0 * x_size, 32.0 * x_size);
+        halide_drotm(x_buffer, y_buffer, P_vector.data());
+
+        return primitive_argument_type(primitive_arguments_type{
+            primitive_argument_type(std::move(x_value)),
+            primitive_argument_type(std::move(y_value))});
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::drotg(
+        primitive_argument_type&& a, primitive_argument_type&& b) const
+    {
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+        double b_value = extract_scalar_numeric_value(std::move(b), name_, codename_);
+        double c_value, s_value;
+        hblas_drotg(&a_value, &b_value, &c_value, &s_value);
+
+        return primitive_argument_type(primitive_arguments_type{
+            primitive_argument_type(a_value), primitive_argument_type(b_value),
+            primitive_argument_type(c_value), primitive_argument_type(s_value)});
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::drotmg(
+        primitive_argument_type&& d1, primitive_argument_type&& d2,
+        primitive_argument_type&& b1, primitive_argument_type&& b2) const
+    {
+        double d1_value = extract_scalar_numeric_value(std::move(d1), name_, codename_);
+        double d2_value = extract_scalar_numeric_value(std::move(d2), name_, codename_);
+        double b1_value = extract_scalar_numeric_value(std::move(b1), name_, codename_);
+        double b2_value = extract_scalar_numeric_value(std::move(b2), name_, codename_);
+
+        blaze::DynamicVector<double> P(5, 0.0);
+        hblas_drotmg(&d1_value, &d2_value, &b1_value, b2_value, P.data());
+
+        return primitive_argument_type(primitive_arguments_type{
+            primitive_argument_type(d1_value), primitive_argument_type(d2_value),
+            primitive_argument_type(b1_value), primitive_argument_type(std::move(P))});
+    }
+
+    namespace {
+
+        // Phylanx matrices are stored row major while the kernels expect
+        // column major matrices, the returned buffer holds the transpose of
+        // the matrix. Its upper triangle is the lower triangle of the matrix
+        // and vice versa.
+        template <typename Matrix>
+        Buffer<double> transposed_buffer(Matrix& m)
+        {
+            halide_dimension_t shape[] = {
+                {0, static_cast<int>(m.columns()), 1},
+                {0, static_cast<int>(m.rows()), static_cast<int>(m.spacing())}};
+            return Buffer<double>(m.data(), 2, shape);
+        }
+
+        // Stacks of row-major matrices as stacks of column-major ones, see
+        // above. The pages are the third dimension.
+        template <typename Tensor>
+        Buffer<double> transposed_pages_buffer(Tensor& t)
+        {
+            halide_dimension_t shape[] = {
+                {0, static_cast<int>(t.columns()), 1},
+                {0, static_cast<int>(t.rows()), static_cast<int>(t.spacing())},
+                {0, static_cast<int>(t.pages()),
+                    static_cast<int>(t.rows() * t.spacing())}};
+            return Buffer<double>(t.data(), 3, shape);
+        }
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dsymv(
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& a,
+        primitive_argument_type&& A,
+        primitive_argument_type&& x,
+        primitive_argument_type&& b,
+        primitive_argument_type&& y)  const
+    {
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+        double b_value = extract_scalar_numeric_value(std::move(b), name_, codename_);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        Buffer<double> A_buffer = transposed_buffer(matrix_A);
+
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
+
+        auto y_value = phylanx::execution_tree::extract_numeric_value(std::move(y), name_, codename_);
+        auto y_vector = y_value.vector();
+        int y_size = y_vector.size();
+        Buffer<double> y_buffer(y_vector.data(), y_size);
+
+        double const n = x_size;
+
+        phylanx_halide_common::pipeline_scope scope("dsymv");
+        phylanx_halide_common::kernel_timer timer(
+            "dsymv", 2.0 * n * n, 8.0 * (0.5 * n * n + 3 * n));
+        halide_dsymv(!lower, a_value, A_buffer, x_buffer, b_value, y_buffer);
+
+        return primitive_argument_type(std::move(y_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dsyr(
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& a,
+        primitive_argument_type&& x,
+        primitive_argument_type&& A)  const
+    {
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        Buffer<double> A_buffer = transposed_buffer(matrix_A);
+
+        double const n = x_size;
+
+        phylanx_halide_common::pipeline_scope scope("dsyr");
+        phylanx_halide_common::kernel_timer timer(
+            "dsyr", n * n, 8.0 * (n * n + n));
+        halide_dsyr(!lower, a_value, x_buffer, A_buffer);
+
+        return primitive_argument_type(std::move(A_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dsyr2(
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& a,
+        primitive_argument_type&& x,
+        primitive_argument_type&& y,
+        primitive_argument_type&& A)  const
+    {
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
+
+        auto y_value = phylanx::execution_tree::extract_numeric_value(std::move(y), name_, codename_);
+        auto y_vector = y_value.vector();
+        int y_size = y_vector.size();
+        Buffer<double> y_buffer(y_vector.data(), y_size);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        Buffer<double> A_buffer = transposed_buffer(matrix_A);
+
+        double const n = x_size;
+
+        phylanx_halide_common::pipeline_scope scope("dsyr2");
+        phylanx_halide_common::kernel_timer timer(
+            "dsyr2", 2.0 * n * n, 8.0 * (n * n + 2 * n));
+        halide_dsyr2(!lower, a_value, x_buffer, y_buffer, A_buffer);
+
+        return primitive_argument_type(std::move(A_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dtrmv(
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& is_trans,
+        primitive_argument_type&& is_unit,
+        primitive_argument_type&& A,
+        primitive_argument_type&& x)  const
+    {
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        bool trans = static_cast<bool> (extract_boolean_value(std::move(is_trans), name_, codename_));
+        bool unit = static_cast<bool> (extract_boolean_value(std::move(is_unit), name_, codename_));
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        Buffer<double> A_buffer = transposed_buffer(matrix_A);
+
+        auto x_value = phylanx::execution_tree::extract_numeric_value(std::move(x), name_, codename_);
+        auto x_vector = x_value.vector();
+        int x_size = x_vector.size();
+        Buffer<double> x_buffer(x_vector.data(), x_size);
+
+        double const n = x_size;
+
+        // op(A) is op'(A**T) with the transposition flipped
+        phylanx_halide_common::pipeline_scope scope("dtrmv");
+        phylanx_halide_common::kernel_timer timer(
+            "dtrmv", n * n, 8.0 * (0.5 * n * n + 2 * n));
+        halide_dtrmv(!lower, !trans, unit, A_buffer, x_buffer);
+
+        return primitive_argument_type(std::move(x_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dtrsv(
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& is_trans,
+        primitive_argument_type&& is_unit,
+        primitive_argument_type&& A,
+        primitive_argument_type&& b)  const
+    {
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        bool trans = static_cast<bool> (extract_boolean_value(std::move(is_trans), name_, codename_));
+        bool unit = static_cast<bool> (extract_boolean_value(std::move(is_unit), name_, codename_));
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        Buffer<double> A_buffer = transposed_buffer(matrix_A);
+
+        auto b_value = phylanx::execution_tree::extract_numeric_value(std::move(b), name_, codename_);
+        auto b_vector = b_value.vector();
+        int b_size = b_vector.size();
+        Buffer<double> b_buffer(b_vector.data(), b_size);
+
+        double const n = b_size;
+
+        // op(A) is op'(A**T) with the transposition flipped
+        phylanx_halide_common::pipeline_scope scope("dtrsv");
+        phylanx_halide_common::kernel_timer timer(
+            "dtrsv", n * n, 8.0 * (0.5 * n * n + 2 * n));
+        halide_dtrsv(!lower, !trans, unit, A_buffer, b_buffer);
+
+        return primitive_argument_type(std::move(b_value));
+    }
+
+    // The level 3 primitives call the blocked drivers behind the hblas_*
+    // interface. Those take column-major matrices, which see the row-major
+    // matrices here transposed: the stored triangles, the transpositions of
+    // the rank k updates and the sides of the products are flipped
+    // accordingly.
+    phylanx::execution_tree::primitive_argument_type blas::dsyrk(
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& is_trans,
+        primitive_argument_type&& a,
+        primitive_argument_type&& A,
+        primitive_argument_type&& b,
+        primitive_argument_type&& C)  const
+    {
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        bool trans = static_cast<bool> (extract_boolean_value(std::move(is_trans), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+        double b_value = extract_scalar_numeric_value(std::move(b), name_, codename_);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        auto C_value = phylanx::execution_tree::extract_numeric_value(std::move(C), name_, codename_);
+        auto matrix_C = C_value.matrix();
+
+        int const n = static_cast<int>(matrix_C.rows());
+        int const k = static_cast<int>(trans ? matrix_A.rows() : matrix_A.columns());
+
+        phylanx_halide_common::pipeline_scope scope("dsyrk");
+        phylanx_halide_common::kernel_timer timer(
+            "dsyrk", double(n) * n * k, 8.0 * (double(n) * k + double(n) * n));
+        hblas_dsyrk(HblasColMajor, lower ? HblasUpper : HblasLower,
+            trans ? HblasNoTrans : HblasTrans, n, k, a_value, matrix_A.data(),
+            static_cast<int>(matrix_A.spacing()), b_value, matrix_C.data(),
+            static_cast<int>(matrix_C.spacing()));
+
+        return primitive_argument_type(std::move(C_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dsyr2k(
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& is_trans,
+        primitive_argument_type&& a,
+        primitive_argument_type&& A,
+        primitive_argument_type&& B,
+        primitive_argument_type&& b,
+        primitive_argument_type&& C)  const
+    {
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        bool trans = static_cast<bool> (extract_boolean_value(std::move(is_trans), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+        double b_value = extract_scalar_numeric_value(std::move(b), name_, codename_);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        auto B_value = phylanx::execution_tree::extract_numeric_value(std::move(B), name_, codename_);
+        auto matrix_B = B_value.matrix();
+        auto C_value = phylanx::execution_tree::extract_numeric_value(std::move(C), name_, codename_);
+        auto matrix_C = C_value.matrix();
+
+        int const n = static_cast<int>(matrix_C.rows());
+        int const k = static_cast<int>(trans ? matrix_A.rows() : matrix_A.columns());
+
+        phylanx_halide_common::pipeline_scope scope("dsyr2k");
+        phylanx_halide_common::kernel_timer timer(
+            "dsyr2k", 2.0 * n * n * k, 8.0 * (2.0 * n * k + double(n) * n));
+        hblas_dsyr2k(HblasColMajor, lower ? HblasUpper : HblasLower,
+            trans ? HblasNoTrans : HblasTrans, n, k, a_value, matrix_A.data(),
+            static_cast<int>(matrix_A.spacing()), matrix_B.data(),
+            static_cast<int>(matrix_B.spacing()), b_value, matrix_C.data(),
+            static_cast<int>(matrix_C.spacing()));
+
+        return primitive_argument_type(std::move(C_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dsymm(
+        primitive_argument_type&& is_right,
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& a,
+        primitive_argument_type&& A,
+        primitive_argument_type&& B,
+        primitive_argument_type&& b,
+        primitive_argument_type&& C)  const
+    {
+        bool right = static_cast<bool> (extract_boolean_value(std::move(is_right), name_, codename_));
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+        double b_value = extract_scalar_numeric_value(std::move(b), name_, codename_);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        auto B_value = phylanx::execution_tree::extract_numeric_value(std::move(B), name_, codename_);
+        auto matrix_B = B_value.matrix();
+        auto C_value = phylanx::execution_tree::extract_numeric_value(std::move(C), name_, codename_);
+        auto matrix_C = C_value.matrix();
+
+        // C**T is m x n
+        int const m = static_cast<int>(matrix_C.columns());
+        int const n = static_cast<int>(matrix_C.rows());
+        double const size = double(matrix_A.rows());
+
+        phylanx_halide_common::pipeline_scope scope("dsymm");
+        phylanx_halide_common::kernel_timer timer(
+            "dsymm", 2.0 * m * n * size, 8.0 * (0.5 * size * size + 3.0 * m * n));
+        hblas_dsymm(HblasColMajor, right ? HblasLeft : HblasRight,
+            lower ? HblasUpper : HblasLower, m, n, a_value, matrix_A.data(),
+            static_cast<int>(matrix_A.spacing()), matrix_B.data(),
+            static_cast<int>(matrix_B.spacing()), b_value, matrix_C.data(),
+            static_cast<int>(matrix_C.spacing()));
+
+        return primitive_argument_type(std::move(C_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dtrmm(
+        primitive_argument_type&& is_right,
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& is_trans,
+        primitive_argument_type&& is_unit,
+        primitive_argument_type&& a,
+        primitive_argument_type&& A,
+        primitive_argument_type&& B)  const
+    {
+        bool right = static_cast<bool> (extract_boolean_value(std::move(is_right), name_, codename_));
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        bool trans = static_cast<bool> (extract_boolean_value(std::move(is_trans), name_, codename_));
+        bool unit = static_cast<bool> (extract_boolean_value(std::move(is_unit), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        auto B_value = phylanx::execution_tree::extract_numeric_value(std::move(B), name_, codename_);
+        auto matrix_B = B_value.matrix();
+
+        // B**T is m x n, op(A)**T is op(A**T) with the same transposition
+        int const m = static_cast<int>(matrix_B.columns());
+        int const n = static_cast<int>(matrix_B.rows());
+        double const size = double(matrix_A.rows());
+
+        phylanx_halide_common::pipeline_scope scope("dtrmm");
+        phylanx_halide_common::kernel_timer timer(
+            "dtrmm", double(m) * n * size, 8.0 * (0.5 * size * size + 2.0 * m * n));
+        hblas_dtrmm(HblasColMajor, right ? HblasLeft : HblasRight,
+            lower ? HblasUpper : HblasLower, trans ? HblasTrans : HblasNoTrans,
+            unit ? HblasUnit : HblasNonUnit, m, n, a_value, matrix_A.data(),
+            static_cast<int>(matrix_A.spacing()), matrix_B.data(),
+            static_cast<int>(matrix_B.spacing()));
+
+        return primitive_argument_type(std::move(B_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dtrsm(
+        primitive_argument_type&& is_right,
+        primitive_argument_type&& is_lower,
+        primitive_argument_type&& is_trans,
+        primitive_argument_type&& is_unit,
+        primitive_argument_type&& a,
+        primitive_argument_type&& A,
+        primitive_argument_type&& B)  const
+    {
+        bool right = static_cast<bool> (extract_boolean_value(std::move(is_right), name_, codename_));
+        bool lower = static_cast<bool> (extract_boolean_value(std::move(is_lower), name_, codename_));
+        bool trans = static_cast<bool> (extract_boolean_value(std::move(is_trans), name_, codename_));
+        bool unit = static_cast<bool> (extract_boolean_value(std::move(is_unit), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto matrix_A = A_value.matrix();
+        auto B_value = phylanx::execution_tree::extract_numeric_value(std::move(B), name_, codename_);
+        auto matrix_B = B_value.matrix();
+
+        // see dtrmm
+        int const m = static_cast<int>(matrix_B.columns());
+        int const n = static_cast<int>(matrix_B.rows());
+        double const size = double(matrix_A.rows());
+
+        phylanx_halide_common::pipeline_scope scope("dtrsm");
+        phylanx_halide_common::kernel_timer timer(
+            "dtrsm", double(m) * n * size, 8.0 * (0.5 * size * size + 2.0 * m * n));
+        hblas_dtrsm(HblasColMajor, right ? HblasLeft : HblasRight,
+            lower ? HblasUpper : HblasLower, trans ? HblasTrans : HblasNoTrans,
+            unit ? HblasUnit : HblasNonUnit, m, n, a_value, matrix_A.data(),
+            static_cast<int>(matrix_A.spacing()), matrix_B.data(),
+            static_cast<int>(matrix_B.spacing()));
+
+        return primitive_argument_type(std::move(B_value));
+    }
+
+    phylanx::execution_tree::primitive_argument_type blas::dgemm_batched(
+        primitive_argument_type&& is_a_trans,
+        primitive_argument_type&& is_b_trans,
+        primitive_argument_type&& a,
+        primitive_argument_type&& A,
+        primitive_argument_type&& B,
+        primitive_argument_type&& b,
+        primitive_argument_type&& C)  const
+    {
+        bool is_a = static_cast<bool> (extract_boolean_value(std::move(is_a_trans), name_, codename_));
+        bool is_b = static_cast<bool> (extract_boolean_value(std::move(is_b_trans), name_, codename_));
+        double a_value = extract_scalar_numeric_value(std::move(a), name_, codename_);
+        double b_value = extract_scalar_numeric_value(std::move(b), name_, codename_);
+
+        auto A_value = phylanx::execution_tree::extract_numeric_value(std::move(A), name_, codename_);
+        auto tensor_A = A_value.tensor();
+        auto B_value = phylanx::execution_tree::extract_numeric_value(std::move(B), name_, codename_);
+        auto tensor_B = B_value.tensor();
+        auto C_value = phylanx::execution_tree::extract_numeric_value(std::move(C), name_, codename_);
+        auto tensor_C = C_value.tensor();
+
+        if (tensor_A.pages() != tensor_C.pages() ||
+            tensor_B.pages() != tensor_C.pages())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "blas::dgemm_batched",
+                generate_error_message(
+                    "the operands of dgemm_batched must hold the same number "
+                    "of matrices"));
+        }
+
+        // op(A) is m x k, op(B) is k x n, the pages of C are m x n
+        std::size_t const m = is_a ? tensor_A.columns() : tensor_A.rows();
+        std::size_t const k_A = is_a ? tensor_A.rows() : tensor_A.columns();
+        std::size_t const k_B = is_b ? tensor_B.columns() : tensor_B.rows();
+        std::size_t const n = is_b ? tensor_B.rows() : tensor_B.columns();
+        if (k_A != k_B || tensor_C.rows() != m || tensor_C.columns() != n)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "blas::dgemm_batched",
+                generate_error_message(
+                    "the shapes of the matrices of dgemm_batched do not "
+                    "match, op(A) has to be m x k, op(B) k x n and C m x n"));
+        }
+
+        Buffer<double> A_buffer = transposed_pages_buffer(tensor_A);
+        Buffer<double> B_buffer = transposed_pages_buffer(tensor_B);
+        Buffer<double> C_buffer = transposed_pages_buffer(tensor_C);
+
+        double const k = double(k_A);
+        double const mn = double(tensor_C.pages()) * m * n;
+        double const elements = double(tensor_A.pages()) * tensor_A.rows() * tensor_A.columns() +
+            double(tensor_B.pages()) * tensor_B.rows() * tensor_B.columns() + 2 * mn;
+
+        // the buffers hold the transposed pages, C**T = op(B)**T * op(A)**T
+        // is computed with the operands swapped
+        phylanx_halide_common::pipeline_scope scope("dgemm_batched");
+        phylanx_halide_common::kernel_timer timer(
+            "dgemm_batched", 2.0 * mn * k, 8.0 * elements);
+        if (halide_dgemm_batched(
+                is_b, is_a, a_value, B_buffer, A_buffer, b_value, C_buffer) != 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "blas::dgemm_batched",
+                generate_error_message(
+                    "the dgemm_batched kernel reported an error"));
+        }
+
+        return primitive_argument_type(std::move(C_value));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<phylanx::execution_tree::primitive_argument_type> blas::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        using phylanx_halide_common::launch_kernel;
+        using phylanx_halide_common::operand_values;
+
+        // operations on small operands run inline, all others on a new HPX
+        // thread
+        static phylanx_halide_common::launch_policy const policy(
+            "blas", 65536);
+
+        auto this_ = this->shared_from_this();
+
+        if (2 == operands.size() && this_->mode_ == DSCAL)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dscal(std::move(a[0]), std::move(a[1]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (3 == operands.size() && this_->mode_ == DASUM)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dasum(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (3 == operands.size() && this_->mode_ == DNRM2)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dnrm2(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (3 == operands.size() && this_->mode_ == DAXPY)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->daxpy(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (6 == operands.size() && this_->mode_ == DGEMV)
         {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& x,
-                    hpx::future<primitive_argument_type>&& y,
-                    hpx::future<primitive_argument_type>&& A)
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
                 ->primitive_argument_type {
-                return this_->dger(a.get(), x.get(), y.get(), A.get());
+                return this_->dgemv(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]));
             },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[3], args, name_, codename_, ctx));
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (4 == operands.size() && this_->mode_ == DGER)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dger(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
         }
 
         if (7 == operands.size() && this_->mode_ == DGEMM)
         {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& is_a_trans,
-                    hpx::future<primitive_argument_type>&& is_b_trans,
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& A,
-                    hpx::future<primitive_argument_type>&& B,
-                    hpx::future<primitive_argument_type>&& b,
-                    hpx::future<primitive_argument_type>&& C)
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dgemm(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]), std::move(a[6]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+        if (3 == operands.size() && this_->mode_ == IDAMAX)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->idamax(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (2 == operands.size() && this_->mode_ == DSWAP)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dswap(std::move(a[0]), std::move(a[1]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (4 == operands.size() && this_->mode_ == DAXPBY)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->daxpby(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (4 == operands.size() && this_->mode_ == DROT)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->drot(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (3 == operands.size() && this_->mode_ == DROTM)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->drotm(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (2 == operands.size() && this_->mode_ == DROTG)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->drotg(std::move(a[0]), std::move(a[1]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (4 == operands.size() && this_->mode_ == DROTMG)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->drotmg(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+        if (6 == operands.size() && this_->mode_ == DSYMV)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dsymv(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (4 == operands.size() && this_->mode_ == DSYR)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dsyr(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (5 == operands.size() && this_->mode_ == DSYR2)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dsyr2(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (5 == operands.size() && this_->mode_ == DTRMV)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dtrmv(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (5 == operands.size() && this_->mode_ == DTRSV)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dtrsv(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (6 == operands.size() && this_->mode_ == DSYRK)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dsyrk(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (7 == operands.size() && this_->mode_ == DSYR2K)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dsyr2k(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]), std::move(a[6]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (7 == operands.size() && this_->mode_ == DSYMM)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dsymm(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]), std::move(a[6]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (7 == operands.size() && this_->mode_ == DTRMM)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dtrmm(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]), std::move(a[6]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (7 == operands.size() && this_->mode_ == DTRSM)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
+                ->primitive_argument_type {
+                return this_->dtrsm(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]), std::move(a[6]));
+            },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (7 == operands.size() && this_->mode_ == DGEMM_BATCHED)
+        {
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
                 ->primitive_argument_type {
-                return this_->dgemm(is_a_trans.get(), is_b_trans.get(), a.get(), A.get(),
-                    B.get(), b.get(), C.get());
+                return this_->dgemm_batched(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]), std::move(a[6]));
             },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[3], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[4], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[5], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[6], args, name_, codename_, ctx));
+                operand_values(operands, args, name_, codename_, ctx));
         }
         HPX_THROW_EXCEPTION(hpx::bad_parameter,
             "Non BLAS function",
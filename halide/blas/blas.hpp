@@ -106,7 +106,195 @@ namespace phylanx_halide_plugin {
             primitive_argument_type&& C /* halide_buffer_t */) const;
 
 
-    
+    ///////////////////////////////////////////////////////////////////////////
+    // IDAMAX finds the (zero based) index of the first element having the
+    // maximum absolute value.
+        primitive_argument_type idamax(
+            primitive_argument_type&& N /* const int */,
+            primitive_argument_type&& X /* const double* */,
+            primitive_argument_type&& incX /* const int */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DSWAP interchanges two vectors, returns the list [x, y].
+        primitive_argument_type dswap(
+            primitive_argument_type&& x /* halide_buffer_t */,
+            primitive_argument_type&& y /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DAXPBY constant times a vector plus constant times a vector,
+    // y := alpha*x + beta*y
+        primitive_argument_type daxpby(
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& x /* halide_buffer_t */,
+            primitive_argument_type&& b /* double */,
+            primitive_argument_type&& y /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DROT applies a plane rotation, returns the list [x, y].
+        primitive_argument_type drot(
+            primitive_argument_type&& x /* halide_buffer_t */,
+            primitive_argument_type&& y /* halide_buffer_t */,
+            primitive_argument_type&& c /* double */,
+            primitive_argument_type&& s /* double */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DROTM applies the modified Givens transformation H given by
+    // P = [flag, h11, h21, h12, h22], returns the list [x, y].
+        primitive_argument_type drotm(
+            primitive_argument_type&& x /* halide_buffer_t */,
+            primitive_argument_type&& y /* halide_buffer_t */,
+            primitive_argument_type&& P /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DROTG constructs a Givens plane rotation, returns the list
+    // [r, z, c, s].
+        primitive_argument_type drotg(
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& b /* double */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DROTMG constructs the modified Givens transformation, returns the list
+    // [d1, d2, b1, P].
+        primitive_argument_type drotmg(
+            primitive_argument_type&& d1 /* double */,
+            primitive_argument_type&& d2 /* double */,
+            primitive_argument_type&& b1 /* double */,
+            primitive_argument_type&& b2 /* double */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DSYMV  performs the matrix-vector operation
+    // y := alpha*A*x + beta*y,
+    // where A is a symmetric matrix of which only the upper (or lower)
+    // triangle is read.
+        primitive_argument_type dsymv(
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& x /* halide_buffer_t */,
+            primitive_argument_type&& b /* double */,
+            primitive_argument_type&& y /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DSYR   performs the symmetric rank 1 operation
+    // A := alpha*x*x**T + A,
+    // updating only the upper (or lower) triangle of A.
+        primitive_argument_type dsyr(
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& x /* halide_buffer_t */,
+            primitive_argument_type&& A /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DSYR2  performs the symmetric rank 2 operation
+    // A := alpha*x*y**T + alpha*y*x**T + A,
+    // updating only the upper (or lower) triangle of A.
+        primitive_argument_type dsyr2(
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& x /* halide_buffer_t */,
+            primitive_argument_type&& y /* halide_buffer_t */,
+            primitive_argument_type&& A /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DTRMV  performs one of the matrix-vector operations
+    // x := A*x,   or   x := A**T*x,
+    // where A is an upper (or lower), unit or non-unit triangular matrix.
+        primitive_argument_type dtrmv(
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& is_trans /* bool */,
+            primitive_argument_type&& is_unit /* bool */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& x /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DTRSV  solves one of the systems of equations
+    // A*x = b,   or   A**T*x = b,
+    // where A is an upper (or lower), unit or non-unit triangular matrix.
+        primitive_argument_type dtrsv(
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& is_trans /* bool */,
+            primitive_argument_type&& is_unit /* bool */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& b /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DSYRK  performs one of the symmetric rank k operations
+    // C := alpha*A*A**T + beta*C,   or   C := alpha*A**T*A + beta*C,
+    // updating only the upper (or lower) triangle of C.
+        primitive_argument_type dsyrk(
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& is_trans /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& b /* double */,
+            primitive_argument_type&& C /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DSYR2K performs one of the symmetric rank 2k operations
+    // C := alpha*A*B**T + alpha*B*A**T + beta*C,   or
+    // C := alpha*A**T*B + alpha*B**T*A + beta*C,
+    // updating only the upper (or lower) triangle of C.
+        primitive_argument_type dsyr2k(
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& is_trans /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& B /* halide_buffer_t */,
+            primitive_argument_type&& b /* double */,
+            primitive_argument_type&& C /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DSYMM  performs one of the matrix-matrix operations
+    // C := alpha*A*B + beta*C,   or   C := alpha*B*A + beta*C,
+    // where A is a symmetric matrix of which only the upper (or lower)
+    // triangle is read.
+        primitive_argument_type dsymm(
+            primitive_argument_type&& is_right /* bool */,
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& B /* halide_buffer_t */,
+            primitive_argument_type&& b /* double */,
+            primitive_argument_type&& C /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DTRMM  performs one of the matrix-matrix operations
+    // B := alpha*op(A)*B,   or   B := alpha*B*op(A),
+    // where A is an upper (or lower), unit or non-unit triangular matrix.
+        primitive_argument_type dtrmm(
+            primitive_argument_type&& is_right /* bool */,
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& is_trans /* bool */,
+            primitive_argument_type&& is_unit /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& B /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DTRSM  solves one of the matrix equations
+    // op(A)*X = alpha*B,   or   X*op(A) = alpha*B,
+    // where A is an upper (or lower), unit or non-unit triangular matrix.
+        primitive_argument_type dtrsm(
+            primitive_argument_type&& is_right /* bool */,
+            primitive_argument_type&& is_lower /* bool */,
+            primitive_argument_type&& is_trans /* bool */,
+            primitive_argument_type&& is_unit /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& B /* halide_buffer_t */) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DGEMM_BATCHED performs DGEMM on every page of the tensors A, B and C,
+    // C[n] := alpha*op( A[n] )*op( B[n] ) + beta*C[n],
+    // in a single kernel launch parallelized over the pages.
+        primitive_argument_type dgemm_batched(
+            primitive_argument_type&& is_a_trans /* bool */,
+            primitive_argument_type&& is_b_trans /* bool */,
+            primitive_argument_type&& a /* double */,
+            primitive_argument_type&& A /* halide_buffer_t */,
+            primitive_argument_type&& B /* halide_buffer_t */,
+            primitive_argument_type&& b /* double */,
+            primitive_argument_type&& C /* halide_buffer_t */) const;
 
     public:
         enum blas_mode
@@ -117,7 +305,25 @@ namespace phylanx_halide_plugin {
             DAXPY,
             DGEMV,
             DGER,
-            DGEMM
+            DGEMM,
+            IDAMAX,
+            DSWAP,
+            DAXPBY,
+            DROT,
+            DROTM,
+            DROTG,
+            DROTMG,
+            DSYMV,
+            DSYR,
+            DSYR2,
+            DTRMV,
+            DTRSV,
+            DSYRK,
+            DSYR2K,
+            DSYMM,
+            DTRMM,
+            DTRSM,
+            DGEMM_BATCHED
         };
 
         static std::vector<phylanx::execution_tree::match_pattern_type> const
@@ -1,10 +1,49 @@
 #include "Halide.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 using namespace Halide;
 
 namespace {
 
+// Split the reduction over the vectors of the input into chunks of
+// block_size elements, each chunk is summed up by its own task (rfactor) and
+// the partial sums are combined in the order of the chunks afterwards. The
+// chunks don't depend on the number of threads, which keeps the result
+// reproducible.
+inline void schedule_partials(Func accum, RDom k, Var i, int vec_size, int block_size) {
+    Var u("u");
+    RVar ko("ko"), ki("ki");
+    Func partials = accum.update(0)
+                        .split(k.x, ko, ki, std::max(1, block_size / vec_size))
+                        .rfactor(ko, u);
+    partials.compute_root()
+        .vectorize(i)
+        .parallel(u);
+    partials.update(0)
+        .reorder(i, ki, u)
+        .vectorize(i)
+        .parallel(u);
+}
+
+// Schedule the update of an element-wise operation over the full vectors of
+// its input: vectorized and, if parallel, split into one task per block_size
+// elements.
+inline void schedule_elementwise(Func f, RDom vecs, int vec_size, bool parallel, int block_size) {
+    if (parallel) {
+        RVar vo("vo"), vi("vi");
+        f.update(0)
+            .split(vecs.x, vo, vi, std::max(block_size, vec_size))
+            .parallel(vo);
+        if (vec_size > 1) {
+            f.update(0).vectorize(vi, vec_size);
+        }
+    } else if (vec_size > 1) {
+        f.update(0).vectorize(vecs.x, vec_size);
+    }
+}
+
 // Generator class for BLAS axpy operations.
 template<class T>
 class AXPYGenerator : public Generator<AXPYGenerator<T>> {
@@ -69,6 +108,166 @@ public:
     }
 };
 
+// Generator class for BLAS axpby operations: y = a * x + b * y.
+template<class T>
+class AXPBYGenerator : public Generator<AXPBYGenerator<T>> {
+public:
+    typedef Generator<AXPBYGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1024};
+
+    Input<T> a_ = {"a", 1};
+    Input<Buffer<T>> x_ = {"x", 1};
+    Input<T> b_ = {"b", 1};
+    Input<Buffer<T>> y_ = {"y", 1};
+
+    Output<Buffer<T>> result_ = {"result", 1};
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        Expr size = x_.width();
+        Expr size_vecs = (size / vec_size) * vec_size;
+        Expr size_tail = size - size_vecs;
+
+        Var i("i");
+        RDom vecs(0, size_vecs, "vec");
+        RDom tail(size_vecs, size_tail, "tail");
+        result_(i) = undef(type_of<T>());
+        result_(vecs) = a_ * x_(vecs) + b_ * y_(vecs);
+        result_(tail) = a_ * x_(tail) + b_ * y_(tail);
+
+        schedule_elementwise(result_, vecs, vec_size, parallel_, block_size_);
+
+        result_.bound(i, 0, x_.width());
+        result_.dim(0).set_bounds(0, x_.width());
+
+        x_.dim(0).set_min(0);
+        y_.dim(0).set_bounds(0, x_.width());
+    }
+};
+
+// Generator class for BLAS swap operations. Both results are computed in the
+// same loop, reading x and y before writing either, which allows them to be
+// written in place.
+template<class T>
+class SwapGenerator : public Generator<SwapGenerator<T>> {
+public:
+    typedef Generator<SwapGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1024};
+
+    Input<Buffer<T>> x_ = {"x", 1};
+    Input<Buffer<T>> y_ = {"y", 1};
+
+    Output<Func> result_ = {"result", {type_of<T>(), type_of<T>()}, 1};
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        Expr size = x_.width();
+        Expr size_vecs = (size / vec_size) * vec_size;
+        Expr size_tail = size - size_vecs;
+
+        Var i("i");
+        RDom vecs(0, size_vecs, "vec");
+        RDom tail(size_vecs, size_tail, "tail");
+        result_(i) = Tuple(undef(type_of<T>()), undef(type_of<T>()));
+        result_(vecs) = Tuple(y_(vecs), x_(vecs));
+        result_(tail) = Tuple(y_(tail), x_(tail));
+
+        schedule_elementwise(result_, vecs, vec_size, parallel_, block_size_);
+
+        result_.bound(i, 0, x_.width());
+        for (auto &output : result_.output_buffers()) {
+            output.dim(0).set_bounds(0, x_.width());
+        }
+
+        x_.dim(0).set_min(0);
+        y_.dim(0).set_bounds(0, x_.width());
+    }
+};
+
+// Generator class for BLAS rot and rotm operations, applying the plane
+// rotation (or modified rotation) H = [h11 h12; h21 h22] to the pairs
+// (x(i), y(i)). Like swap, both results are computed in the same loop.
+template<class T>
+class RotGenerator : public Generator<RotGenerator<T>> {
+public:
+    typedef Generator<RotGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1024};
+
+    Input<Buffer<T>> x_ = {"x", 1};
+    Input<Buffer<T>> y_ = {"y", 1};
+    Input<T> h11_ = {"h11", 1};
+    Input<T> h21_ = {"h21", 0};
+    Input<T> h12_ = {"h12", 0};
+    Input<T> h22_ = {"h22", 1};
+
+    Output<Func> result_ = {"result", {type_of<T>(), type_of<T>()}, 1};
+
+    template<class Arg>
+    Tuple calc(Arg i) {
+        return Tuple(h11_ * x_(i) + h12_ * y_(i), h21_ * x_(i) + h22_ * y_(i));
+    }
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        Expr size = x_.width();
+        Expr size_vecs = (size / vec_size) * vec_size;
+        Expr size_tail = size - size_vecs;
+
+        Var i("i");
+        RDom vecs(0, size_vecs, "vec");
+        RDom tail(size_vecs, size_tail, "tail");
+        result_(i) = Tuple(undef(type_of<T>()), undef(type_of<T>()));
+        result_(vecs) = calc(vecs);
+        result_(tail) = calc(tail);
+
+        schedule_elementwise(result_, vecs, vec_size, parallel_, block_size_);
+
+        result_.bound(i, 0, x_.width());
+        for (auto &output : result_.output_buffers()) {
+            output.dim(0).set_bounds(0, x_.width());
+        }
+
+        x_.dim(0).set_min(0);
+        y_.dim(0).set_bounds(0, x_.width());
+    }
+};
+
 // Generator class for BLAS dot operations.
 template<class T>
 class DotGenerator : public Generator<DotGenerator<T>> {
@@ -113,6 +312,10 @@ public:
 
             dot.compute_root().vectorize(i);
             dot.update(0).vectorize(i);
+
+            if (parallel_) {
+                schedule_partials(dot, k, i, vec_size, block_size_);
+            }
         } else {
             RDom k(0, size);
             result_() = sum(x_(k) * y_(k));
@@ -166,6 +369,10 @@ public:
 
             norm.compute_root().vectorize(i);
             norm.update(0).vectorize(i);
+
+            if (parallel_) {
+                schedule_partials(norm, k, i, vec_size, block_size_);
+            }
         } else {
             RDom k(0, x_.width());
             result_() = sum(abs(x_(k)));
@@ -175,6 +382,206 @@ public:
     }
 };
 
+// Exponents of the scaling constants of Blue's algorithm for the Euclidean
+// norm (see LAPACK's la_constants): squares of values below 2^tsml are
+// accumulated scaled up by 2^ssml, squares of values above 2^tbig scaled
+// down by 2^sbig, and all others unscaled.
+template<class T>
+struct BlueExponents;
+
+template<>
+struct BlueExponents<float> {
+    enum { tsml = -63, tbig = 52, ssml = 75, sbig = -76 };
+};
+
+template<>
+struct BlueExponents<double> {
+    enum { tsml = -511, tbig = 486, ssml = 537, sbig = -538 };
+};
+
+// Generator class for BLAS nrm2 operations.
+template<class T>
+class Norm2Generator : public Generator<Norm2Generator<T>> {
+public:
+    typedef Generator<Norm2Generator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1024};
+
+    Input<Buffer<T>> x_ = {"x", 1};
+
+    Output<Buffer<T>> result_ = {"result", 0};
+
+    const T tsml = std::ldexp(T(1), BlueExponents<T>::tsml);
+    const T tbig = std::ldexp(T(1), BlueExponents<T>::tbig);
+    const T ssml = std::ldexp(T(1), BlueExponents<T>::ssml);
+    const T sbig = std::ldexp(T(1), BlueExponents<T>::sbig);
+
+    // The contribution of one element to the small, medium and big sum of
+    // squares. NaNs end up in the medium sum and propagate to the result.
+    Tuple squares(Expr x) {
+        Expr ax = abs(x);
+        Expr small = ax < tsml;
+        Expr big = ax > tbig;
+        Expr zero = cast<T>(0);
+        return Tuple(select(small, (ax * ssml) * (ax * ssml), zero),
+                     select(small || big, zero, ax * ax),
+                     select(big, (ax * sbig) * (ax * sbig), zero));
+    }
+
+    // f() += t for all three sums
+    void accumulate(Func f, std::vector<Expr> args, Tuple t) {
+        f(args) = Tuple(f(args)[0] + t[0], f(args)[1] + t[1], f(args)[2] + t[2]);
+    }
+
+    // Combine the three sums into the norm, scaling such that neither the
+    // intermediate values nor the result over- or underflow unnecessarily.
+    Expr norm(Expr asml, Expr amed, Expr abig) {
+        Expr with_big = sqrt(abig + (amed * sbig) * sbig) / sbig;
+
+        Expr ysml = sqrt(asml) / ssml;
+        Expr ymed = sqrt(amed);
+        Expr ymin = min(ysml, ymed);
+        Expr ymax = max(ysml, ymed);
+        Expr with_small = select(amed > 0, ymax * sqrt(1 + (ymin / ymax) * (ymin / ymax)),
+                                 amed == 0, ysml,
+                                 amed);
+
+        return select(abig > 0, with_big,
+                      asml > 0, with_small,
+                      ymed);
+    }
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        Expr size = x_.width();
+        Expr size_vecs = size / vec_size;
+        Expr size_tail = size - size_vecs * vec_size;
+
+        Expr zero = cast<T>(0);
+        Func sums("sums");
+        sums() = Tuple(zero, zero, zero);
+
+        Var i("i");
+        if (vectorize_) {
+            Func squares_vecs("squares_vecs");
+
+            RDom k(0, size_vecs);
+            squares_vecs(i) = Tuple(zero, zero, zero);
+            accumulate(squares_vecs, {i}, squares(x_(k * vec_size + i)));
+
+            RDom lanes(0, vec_size);
+            RDom tail(size_vecs * vec_size, size_tail);
+            accumulate(sums, {}, Tuple(squares_vecs(lanes)));
+            accumulate(sums, {}, squares(x_(tail)));
+
+            squares_vecs.compute_root().vectorize(i);
+            squares_vecs.update(0).vectorize(i);
+
+            if (parallel_) {
+                schedule_partials(squares_vecs, k, i, vec_size, block_size_);
+            }
+        } else {
+            RDom k(0, size);
+            accumulate(sums, {}, squares(x_(k)));
+        }
+
+        result_() = norm(sums()[0], sums()[1], sums()[2]);
+
+        x_.dim(0).set_min(0);
+    }
+};
+
+// Generator class for BLAS iamax operations: the (zero based) index of the
+// first element with the largest absolute value.
+template<class T>
+class IAMaxGenerator : public Generator<IAMaxGenerator<T>> {
+public:
+    typedef Generator<IAMaxGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1024};
+
+    Input<Buffer<T>> x_ = {"x", 1};
+
+    Output<Buffer<int32_t>> result_ = {"result", 0};
+
+    // f() = the larger of f() and (value, index). Reductions running over
+    // increasing indices keep the first maximum without comparing indices,
+    // which makes them associative for rfactor.
+    void arg_max(Func f, std::vector<Expr> args, Expr value, Expr index, bool compare_indices) {
+        Expr best = f(args)[0];
+        Expr best_index = f(args)[1];
+        if (compare_indices) {
+            Expr better = best < value || (best == value && index < best_index);
+            f(args) = Tuple(select(better, value, best), select(better, index, best_index));
+        } else {
+            f(args) = Tuple(max(best, value), select(best < value, index, best_index));
+        }
+    }
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        Expr size = x_.width();
+        Expr size_vecs = size / vec_size;
+        Expr size_tail = size - size_vecs * vec_size;
+
+        // all absolute values are larger than the initial value
+        Func amax("amax");
+        amax() = Tuple(cast<T>(-1), 0);
+
+        Var i("i");
+        if (vectorize_) {
+            Func lanes_max("lanes_max");
+
+            RDom k(0, size_vecs);
+            Expr index = k * vec_size + i;
+            lanes_max(i) = Tuple(cast<T>(-1), 0);
+            arg_max(lanes_max, {i}, abs(x_(index)), index, false);
+
+            // the lanes interleave, their maxima have to be compared by index
+            RDom lanes(0, vec_size);
+            RDom tail(size_vecs * vec_size, size_tail);
+            arg_max(amax, {}, lanes_max(lanes)[0], lanes_max(lanes)[1], true);
+            arg_max(amax, {}, abs(x_(tail)), tail, false);
+
+            lanes_max.compute_root().vectorize(i);
+            lanes_max.update(0).vectorize(i);
+
+            if (parallel_) {
+                schedule_partials(lanes_max, k, i, vec_size, block_size_);
+            }
+        } else {
+            RDom k(0, size);
+            arg_max(amax, {}, abs(x_(k)), k, false);
+        }
+
+        result_() = amax()[1];
+
+        x_.dim(0).set_min(0);
+    }
+};
+
 }  // namespace
 
 HALIDE_REGISTER_GENERATOR(AXPYGenerator<float>, saxpy)
@@ -183,3 +590,13 @@ HALIDE_REGISTER_GENERATOR(DotGenerator<float>, sdot)
 HALIDE_REGISTER_GENERATOR(DotGenerator<double>, ddot)
 HALIDE_REGISTER_GENERATOR(AbsSumGenerator<float>, sasum)
 HALIDE_REGISTER_GENERATOR(AbsSumGenerator<double>, dasum)
+HALIDE_REGISTER_GENERATOR(Norm2Generator<float>, snrm2)
+HALIDE_REGISTER_GENERATOR(Norm2Generator<double>, dnrm2)
+HALIDE_REGISTER_GENERATOR(AXPBYGenerator<float>, saxpby)
+HALIDE_REGISTER_GENERATOR(AXPBYGenerator<double>, daxpby)
+HALIDE_REGISTER_GENERATOR(SwapGenerator<float>, sswap)
+HALIDE_REGISTER_GENERATOR(SwapGenerator<double>, dswap)
+HALIDE_REGISTER_GENERATOR(RotGenerator<float>, srot)
+HALIDE_REGISTER_GENERATOR(RotGenerator<double>, drot)
+HALIDE_REGISTER_GENERATOR(IAMaxGenerator<float>, isamax)
+HALIDE_REGISTER_GENERATOR(IAMaxGenerator<double>, idamax)
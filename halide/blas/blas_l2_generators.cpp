@@ -1,4 +1,5 @@
 #include "Halide.h"
+#include <algorithm>
 #include <vector>
 
 using namespace Halide;
@@ -70,19 +71,20 @@ public:
             result(i) = b_ * y_(i) + a_ * Ax(i);
 
             Var ii("ii"), t("t");
-            result.specialize((sum_size / vec_size) * vec_size == sum_size)
-                .specialize(size >= unroll_size)
-                .vectorize(i, unroll_size)
-                .specialize(size >= block_size_)
-                .split(i, t, i, block_size_ / unroll_size)
-                .parallel(t);
-
-            result
-                .specialize(size >= unroll_size)
-                .vectorize(i, unroll_size)
-                .specialize(size >= block_size_)
-                .split(i, t, i, block_size_ / unroll_size)
-                .parallel(t);
+            Stage aligned = result.specialize((sum_size / vec_size) * vec_size == sum_size)
+                                .specialize(size >= unroll_size)
+                                .vectorize(i, unroll_size);
+            Stage unaligned = result
+                                  .specialize(size >= unroll_size)
+                                  .vectorize(i, unroll_size);
+            if (parallel_) {
+                aligned.specialize(size >= block_size_)
+                    .split(i, t, i, block_size_ / unroll_size)
+                    .parallel(t);
+                unaligned.specialize(size >= block_size_)
+                    .split(i, t, i, block_size_ / unroll_size)
+                    .parallel(t);
+            }
 
             accum_vecs
                 .compute_at(result, i)
@@ -137,22 +139,23 @@ public:
 
             RVar ki("ki");
             Var ii("ii");
-            result.specialize(tail_size == 0)
-                .specialize(size >= vec_size)
-                .vectorize(i, vec_size)
-                .specialize(size >= unroll_size * vec_size)
-                .unroll(i, unroll_size)
-                .specialize(size >= block_size_)
-                .split(i, i, ii, block_size_ / (unroll_size * vec_size))
-                .parallel(i);
-
-            result.specialize(size >= vec_size)
-                .vectorize(i, vec_size)
-                .specialize(size >= unroll_size * vec_size)
-                .unroll(i, unroll_size)
-                .specialize(size >= block_size_)
-                .split(i, i, ii, block_size_ / (unroll_size * vec_size))
-                .parallel(i);
+            Stage aligned = result.specialize(tail_size == 0)
+                                .specialize(size >= vec_size)
+                                .vectorize(i, vec_size)
+                                .specialize(size >= unroll_size * vec_size)
+                                .unroll(i, unroll_size);
+            Stage unaligned = result.specialize(size >= vec_size)
+                                  .vectorize(i, vec_size)
+                                  .specialize(size >= unroll_size * vec_size)
+                                  .unroll(i, unroll_size);
+            if (parallel_) {
+                aligned.specialize(size >= block_size_)
+                    .split(i, i, ii, block_size_ / (unroll_size * vec_size))
+                    .parallel(i);
+                unaligned.specialize(size >= block_size_)
+                    .split(i, i, ii, block_size_ / (unroll_size * vec_size))
+                    .parallel(i);
+            }
 
             block.compute_at(result, i);
             block.specialize(size >= vec_size)
@@ -186,13 +189,15 @@ public:
 
         const Expr size = x_.width();
         Var ii("ii");
-        output_.specialize(size >= vec_size)
-            .vectorize(i, vec_size)
-            .specialize(size >= unroll_size * vec_size)
-            .unroll(i, unroll_size)
-            .specialize(size >= block_size_)
-            .split(i, i, ii, block_size_ / (unroll_size * vec_size))
-            .parallel(i);
+        Stage copy = output_.specialize(size >= vec_size)
+                         .vectorize(i, vec_size)
+                         .specialize(size >= unroll_size * vec_size)
+                         .unroll(i, unroll_size);
+        if (parallel_) {
+            copy.specialize(size >= block_size_)
+                .split(i, i, ii, block_size_ / (unroll_size * vec_size))
+                .parallel(i);
+        }
     }
 };
 
@@ -242,9 +247,406 @@ public:
     }
 };
 
+// Schedule the update of the stored triangle of a matrix over r, with r.x
+// running down the columns: vectorized along the columns and, for large
+// matrices, one task per block_size columns.
+inline void schedule_triangle(Func f, RDom r, Expr size, int vec_size, bool parallel, int block_size) {
+    if (vec_size > 1) {
+        f.update().vectorize(r.x, vec_size, TailStrategy::GuardWithIf);
+    }
+    if (parallel) {
+        f.update()
+            .specialize(size >= block_size)
+            .parallel(r.y, block_size, TailStrategy::GuardWithIf);
+    }
+}
+
+// Generator class for BLAS symv (SYmmetric Matrix-Vector product) operations.
+// Only the triangle of A selected by 'lower' is read.
+template<class T>
+class SYMVGenerator : public Generator<SYMVGenerator<T>> {
+public:
+    typedef Generator<SYMVGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1 << 6};
+    GeneratorParam<bool> lower_ = {"lower", false};
+
+    // Standard ordering of parameters in SYMV functions.
+    Input<T> a_ = {"a", 1};
+    Input<Buffer<T>> A_ = {"A", 2};
+    Input<Buffer<T>> x_ = {"x", 1};
+    Input<T> b_ = {"b", 1};
+    Input<Buffer<T>> y_ = {"y", 1};
+
+    Output<Buffer<T>> output_ = {"output", 1};
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        const int block_size = block_size_;
+        const int row_block = std::max(vec_size, (1 << 14) / block_size);
+        const Expr size = A_.width();
+        const Expr num_panels = (size + block_size - 1) / block_size;
+
+        // The columns of A are split into panels of block_size columns, the
+        // stored elements of each panel are swept by a task of its own which
+        // accumulates its contributions into partial results of the panel.
+        // The partial results are summed up in the order of the panels, which
+        // keeps the result independent of the number of threads.
+        //
+        // r runs over the stored elements below (or above) the diagonal in
+        // the columns of panel p, r.x is the row and col the column.
+        Var i("i"), j("j"), p("p");
+        RDom r(0, size, 0, block_size, "r");
+        Expr col = p * block_size + r.y;
+        r.where(col < size);
+        if (lower_) {
+            r.where(r.x > col);
+        } else {
+            r.where(r.x < col);
+        }
+
+        // each stored element A(i, k) contributes A(i, k) * x(k) to y(i) ...
+        Func by_columns("by_columns");
+        by_columns(i, p) = cast<T>(0);
+        by_columns(r.x, p) += A_(r.x, col) * x_(col);
+
+        // ... and, standing in for A(k, i), A(i, k) * x(i) to y(k), which
+        // is element k - p * block_size of the partial result of the panel
+        Func by_rows("by_rows");
+        by_rows(j, p) = cast<T>(0);
+        by_rows(r.y, p) += A_(r.x, col) * x_(r.x);
+
+        RDom panels(0, num_panels, "panels");
+        Func product("product");
+        product(i) = A_(i, i) * x_(i) + by_rows(i % block_size, i / block_size);
+        product(i) += by_columns(i, panels);
+
+        output_(i) = b_ * y_(i) + a_ * product(i);
+
+        by_columns.compute_root();
+        by_rows.compute_root();
+
+        // Both products sweep a panel in tiles of row_block rows. Running
+        // them in the same loop over the tiles streams each tile from memory
+        // only once while it is in the cache, half the traffic of a GEMV with
+        // the full matrix. The axpys are vectorized along the rows, the dot
+        // products across the columns of the panel, so that no two lanes
+        // accumulate into the same element.
+        RVar ro("ro"), ri("ri");
+        by_columns.update()
+            .split(r.x, ro, ri, row_block, TailStrategy::GuardWithIf)
+            .reorder(ri, r.y, ro, p);
+        by_rows.update()
+            .split(r.x, ro, ri, row_block, TailStrategy::GuardWithIf)
+            .reorder(r.y, ri, ro, p);
+        by_rows.update().compute_with(by_columns.update(), ro);
+
+        Var io("io"), ii("ii");
+        output_.split(i, io, ii, block_size * row_block, TailStrategy::GuardWithIf);
+        product.compute_at(output_, io);
+        product.update().reorder(i, panels);
+
+        if (vectorize_) {
+            by_columns.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            by_columns.update().vectorize(ri, vec_size, TailStrategy::GuardWithIf);
+            by_rows.vectorize(j, vec_size, TailStrategy::GuardWithIf);
+            by_rows.update().vectorize(r.y, vec_size, TailStrategy::GuardWithIf);
+            product.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            product.update().vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            output_.vectorize(ii, vec_size, TailStrategy::GuardWithIf);
+        }
+        if (parallel_) {
+            // one task per panel, the fused stages share the loop over the
+            // panels
+            by_columns.update().parallel(p);
+            by_rows.update().parallel(p);
+            output_.parallel(io);
+        }
+
+        A_.dim(0).set_min(0).dim(1).set_min(0);
+        x_.dim(0).set_bounds(0, A_.width());
+        y_.dim(0).set_bounds(0, A_.width());
+    }
+};
+
+// Generator class for BLAS syr (SYmmetric Rank-1 update) operations, only
+// the triangle of A selected by 'lower' is updated.
+template<class T>
+class SYRGenerator : public Generator<SYRGenerator<T>> {
+public:
+    typedef Generator<SYRGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1 << 5};
+    GeneratorParam<bool> lower_ = {"lower", false};
+
+    Input<T> a_ = {"a", 1};
+    Input<Buffer<T>> x_ = {"x", 1};
+
+    Output<Buffer<T>> result_ = {"result", 2};
+
+    void generate() {
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        const Expr size = x_.width();
+
+        Var i("i"), j("j");
+        result_(i, j) = undef<T>();  // in-place operation on the output
+
+        RDom r(0, size, 0, size, "r");
+        if (lower_) {
+            r.where(r.x >= r.y);
+        } else {
+            r.where(r.x <= r.y);
+        }
+        result_(r.x, r.y) += (a_ * x_(r.y)) * x_(r.x);
+
+        schedule_triangle(result_, r, size, vec_size, parallel_, block_size_);
+
+        x_.dim(0).set_min(0);
+        result_.dim(0).set_bounds(0, size);
+        result_.dim(1).set_bounds(0, size);
+    }
+};
+
+// Generator class for BLAS syr2 (SYmmetric Rank-2 update) operations, only
+// the triangle of A selected by 'lower' is updated.
+template<class T>
+class SYR2Generator : public Generator<SYR2Generator<T>> {
+public:
+    typedef Generator<SYR2Generator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1 << 5};
+    GeneratorParam<bool> lower_ = {"lower", false};
+
+    Input<T> a_ = {"a", 1};
+    Input<Buffer<T>> x_ = {"x", 1};
+    Input<Buffer<T>> y_ = {"y", 1};
+
+    Output<Buffer<T>> result_ = {"result", 2};
+
+    void generate() {
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        const Expr size = x_.width();
+
+        Var i("i"), j("j");
+        result_(i, j) = undef<T>();  // in-place operation on the output
+
+        RDom r(0, size, 0, size, "r");
+        if (lower_) {
+            r.where(r.x >= r.y);
+        } else {
+            r.where(r.x <= r.y);
+        }
+        result_(r.x, r.y) += (a_ * y_(r.y)) * x_(r.x) + (a_ * x_(r.y)) * y_(r.x);
+
+        schedule_triangle(result_, r, size, vec_size, parallel_, block_size_);
+
+        x_.dim(0).set_min(0);
+        y_.dim(0).set_bounds(0, size);
+        result_.dim(0).set_bounds(0, size);
+        result_.dim(1).set_bounds(0, size);
+    }
+};
+
+// Generator class for BLAS trmv (TRiangular Matrix-Vector product)
+// operations: x := op(A) * x with A upper or lower triangular, unit (the
+// diagonal is not read) or non-unit.
+template<class T>
+class TRMVGenerator : public Generator<TRMVGenerator<T>> {
+public:
+    typedef Generator<TRMVGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1 << 5};
+    GeneratorParam<bool> lower_ = {"lower", false};
+    GeneratorParam<bool> transpose_ = {"transpose", false};
+
+    Input<bool> unit_ = {"unit", false};
+    Input<Buffer<T>> A_ = {"A", 2};
+    Input<Buffer<T>> x_ = {"x", 1};
+
+    Output<Buffer<T>> output_ = {"output", 1};
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        const Expr size = A_.width();
+
+        // the elements of the triangle off the diagonal, r.x is the row and
+        // r.y the column
+        Var i("i");
+        RDom r(0, size, 0, size, "r");
+        if (lower_) {
+            r.where(r.x > r.y);
+        } else {
+            r.where(r.x < r.y);
+        }
+
+        Func product("product");
+        product(i) = select(unit_, x_(i), A_(i, i) * x_(i));
+        if (transpose_) {
+            // one dot product per column of A
+            product(r.y) += A_(r.x, r.y) * x_(r.x);
+        } else {
+            // one axpy per column of A
+            product(r.x) += A_(r.x, r.y) * x_(r.y);
+        }
+
+        // x is overwritten only once the product is complete
+        output_(i) = product(i);
+        product.compute_root();
+
+        if (vectorize_) {
+            product.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            output_.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+        }
+        if (transpose_) {
+            // the columns are independent of each other
+            if (parallel_) {
+                product.update()
+                    .specialize(size >= block_size_)
+                    .parallel(r.y, block_size_, TailStrategy::GuardWithIf);
+            }
+        } else if (vectorize_) {
+            // the axpys accumulate into the same elements, they run in order
+            product.update().vectorize(r.x, vec_size, TailStrategy::GuardWithIf);
+        }
+
+        A_.dim(0).set_min(0).dim(1).set_min(0);
+        x_.dim(0).set_bounds(0, A_.width());
+    }
+};
+
+// Generator class for BLAS trsv (TRiangular SolVe) operations: solves
+// op(A) * x = b in place of b, with A upper or lower triangular, unit or
+// non-unit.
+template<class T>
+class TRSVGenerator : public Generator<TRSVGenerator<T>> {
+public:
+    typedef Generator<TRSVGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> lower_ = {"lower", false};
+    GeneratorParam<bool> transpose_ = {"transpose", false};
+
+    Input<bool> unit_ = {"unit", false};
+    Input<Buffer<T>> A_ = {"A", 2};
+    Input<Buffer<T>> x_ = {"x", 1};
+
+    Output<Buffer<T>> output_ = {"output", 1};
+
+    void generate() {
+        assert(get_target().has_feature(Target::NoBoundsQuery));
+
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        const Expr size = A_.width();
+
+        auto diagonal = [&](Expr k) {
+            return select(unit_, cast<T>(1), A_(k, k));
+        };
+
+        // The unknowns are eliminated in the order of the loop over r.y,
+        // forwards if op(A) is lower triangular, backwards otherwise. The
+        // partial solution holds b minus the contributions of all unknowns
+        // eliminated so far, the unknown k is its value at k divided by the
+        // diagonal element.
+        const bool forward = static_cast<bool>(lower_) != static_cast<bool>(transpose_);
+
+        Var i("i");
+        RDom r(0, size, 0, size, "r");
+        Expr col = forward ? Expr(r.y) : size - 1 - r.y;
+        if (lower_) {
+            r.where(r.x > col);
+        } else {
+            r.where(r.x < col);
+        }
+
+        Func solution("solution");
+        solution(i) = x_(i);
+        if (transpose_) {
+            // the unknown col is the dot product of column col of A with the
+            // unknowns eliminated before
+            solution(col) -= A_(r.x, col) * (solution(r.x) / diagonal(r.x));
+        } else {
+            // the unknown col is eliminated from all others by an axpy with
+            // column col of A
+            solution(r.x) -= A_(r.x, col) * (solution(col) / diagonal(col));
+        }
+
+        output_(i) = solution(i) / diagonal(i);
+        solution.compute_root();
+
+        if (vectorize_) {
+            solution.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            if (!transpose_) {
+                // no element of the column updates the unknown being eliminated
+                solution.update().vectorize(r.x, vec_size, TailStrategy::GuardWithIf);
+            }
+            output_.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+        }
+
+        A_.dim(0).set_min(0).dim(1).set_min(0);
+        x_.dim(0).set_bounds(0, A_.width());
+    }
+};
+
 }  // namespace
 
 HALIDE_REGISTER_GENERATOR(GEMVGenerator<float>, sgemv)
 HALIDE_REGISTER_GENERATOR(GEMVGenerator<double>, dgemv)
 HALIDE_REGISTER_GENERATOR(GERGenerator<float>, sger)
 HALIDE_REGISTER_GENERATOR(GERGenerator<double>, dger)
+HALIDE_REGISTER_GENERATOR(SYMVGenerator<float>, ssymv)
+HALIDE_REGISTER_GENERATOR(SYMVGenerator<double>, dsymv)
+HALIDE_REGISTER_GENERATOR(SYRGenerator<float>, ssyr)
+HALIDE_REGISTER_GENERATOR(SYRGenerator<double>, dsyr)
+HALIDE_REGISTER_GENERATOR(SYR2Generator<float>, ssyr2)
+HALIDE_REGISTER_GENERATOR(SYR2Generator<double>, dsyr2)
+HALIDE_REGISTER_GENERATOR(TRMVGenerator<float>, strmv)
+HALIDE_REGISTER_GENERATOR(TRMVGenerator<double>, dtrmv)
+HALIDE_REGISTER_GENERATOR(TRSVGenerator<float>, strsv)
+HALIDE_REGISTER_GENERATOR(TRSVGenerator<double>, dtrsv)
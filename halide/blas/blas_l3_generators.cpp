@@ -34,9 +34,9 @@ public:
         // Matrices are interpreted as column-major by default. The
         // transpose GeneratorParams are used to handle cases where
         // one or both is actually row major.
-        const Expr num_rows = A_.width();
-        const Expr num_cols = B_.height();
-        const Expr sum_size = A_.height();
+        const Expr num_rows = transpose_A_ ? A_.height() : A_.width();
+        const Expr num_cols = transpose_B_ ? B_.width() : B_.height();
+        const Expr sum_size = transpose_A_ ? A_.width() : A_.height();
 
         const int vec = std::max(4, natural_vector_size(a_.type()));
         const int s = vec * 2;
@@ -165,14 +165,282 @@ public:
         }
 
         A_.dim(0).set_min(0).dim(1).set_min(0);
-        B_.dim(0).set_bounds(0, sum_size).dim(1).set_min(0);
+        if (transpose_B_) {
+            B_.dim(0).set_min(0).dim(1).set_bounds(0, sum_size);
+        } else {
+            B_.dim(0).set_bounds(0, sum_size).dim(1).set_min(0);
+        }
         C_.dim(0).set_bounds(0, num_rows);
         C_.dim(1).set_bounds(0, num_cols);
         result_.dim(0).set_bounds(0, num_rows).dim(1).set_bounds(0, num_cols);
     }
 };
 
+// Generator class for strided batched GEMM: result(_, _, n) = a * op(A_n) *
+// op(B_n) + b * C_n for every matrix n of the stacks A, B and C. This is
+// meant for many small matrices, so instead of tiling each product for the
+// cache like GEMMGenerator, the batch is split into tasks of block_size
+// matrices and each product is computed in register tiles of one vector by
+// four columns.
+template<class T>
+class BatchedGEMMGenerator : public Generator<BatchedGEMMGenerator<T>> {
+public:
+    typedef Generator<BatchedGEMMGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1 << 2};
+    GeneratorParam<bool> transpose_A_ = {"transpose_A", false};
+    GeneratorParam<bool> transpose_B_ = {"transpose_B", false};
+
+    // Standard ordering of parameters in GEMM functions, the third
+    // dimension of A, B and C is the batch.
+    Input<T> a_ = {"a_", 1};
+    Input<Buffer<T>> A_ = {"A_", 3};
+    Input<Buffer<T>> B_ = {"B_", 3};
+    Input<T> b_ = {"b_", 1};
+    Input<Buffer<T>> C_ = {"C_", 3};
+
+    Output<Buffer<T>> result_ = {"result", 3};
+
+    void generate() {
+        const Expr num_rows = transpose_A_ ? A_.height() : A_.width();
+        const Expr num_cols = transpose_B_ ? B_.width() : B_.height();
+        const Expr sum_size = transpose_A_ ? A_.width() : A_.height();
+        const Expr batch_size = C_.dim(2).extent();
+
+        const int vec = std::max(4, natural_vector_size(a_.type()));
+
+        Var i("i"), j("j"), n("n"), ii("ii"), ji("ji"), no("no");
+
+        // the columns of op(A) are vectorized over, so a transposed A is
+        // staged once per matrix
+        Func A("A"), B("B");
+        if (transpose_A_) {
+            A(i, j, n) = A_(j, i, n);
+        } else {
+            A(i, j, n) = A_(i, j, n);
+        }
+        if (transpose_B_) {
+            B(i, j, n) = B_(j, i, n);
+        } else {
+            B(i, j, n) = B_(i, j, n);
+        }
+
+        Func AB("AB");
+        RDom rv(0, sum_size);
+        AB(i, j, n) += A(i, rv, n) * B(rv, j, n);
+
+        result_(i, j, n) = a_ * AB(i, j, n) + b_ * C_(i, j, n);
+
+        // C is updated in place, so no tile or matrix may be computed twice
+        result_.tile(i, j, ii, ji, vec, 4, TailStrategy::GuardWithIf)
+            .vectorize(ii)
+            .unroll(ji);
+        result_.split(n, no, n, block_size_, TailStrategy::GuardWithIf);
+        if (parallel_) {
+            result_.parallel(no);
+        }
+
+        // the tiles at the edges are partial, so guard rather than unroll
+        // over a constant extent
+        AB.compute_at(result_, i)
+            .vectorize(i, vec, TailStrategy::GuardWithIf)
+            .unroll(j, 4, TailStrategy::GuardWithIf)
+            .update()
+            .reorder(i, j, rv)
+            .vectorize(i, vec, TailStrategy::GuardWithIf)
+            .unroll(j, 4, TailStrategy::GuardWithIf);
+
+        if (transpose_A_) {
+            A.compute_at(result_, n)
+                .vectorize(i, vec, TailStrategy::GuardWithIf);
+        }
+
+        A_.dim(0).set_min(0).dim(1).set_min(0).dim(2).set_bounds(0, batch_size);
+        if (transpose_B_) {
+            B_.dim(0).set_min(0).dim(1).set_bounds(0, sum_size);
+        } else {
+            B_.dim(0).set_bounds(0, sum_size).dim(1).set_min(0);
+        }
+        B_.dim(2).set_bounds(0, batch_size);
+        C_.dim(0).set_bounds(0, num_rows).dim(1).set_bounds(0, num_cols).dim(2).set_min(0);
+        result_.dim(0).set_bounds(0, num_rows).dim(1).set_bounds(0, num_cols);
+        result_.dim(2).set_bounds(0, batch_size);
+    }
+};
+
+// Generator class for the diagonal blocks of BLAS trmm (TRiangular Matrix-
+// Matrix product) operations: B := a * op(A) * B with A upper or lower
+// triangular, unit or non-unit. The columns of B are independent and are
+// split into tasks of block_size columns, the off-diagonal blocks of large
+// matrices are handled by GEMM in halide_blas.cpp.
+template<class T>
+class TRMMGenerator : public Generator<TRMMGenerator<T>> {
+public:
+    typedef Generator<TRMMGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1 << 3};
+    GeneratorParam<bool> lower_ = {"lower", false};
+    GeneratorParam<bool> transpose_ = {"transpose", false};
+
+    Input<bool> unit_ = {"unit", false};
+    Input<T> a_ = {"a", 1};
+    Input<Buffer<T>> A_ = {"A", 2};
+    Input<Buffer<T>> B_ = {"B", 2};
+
+    Output<Buffer<T>> output_ = {"output", 2};
+
+    void generate() {
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        const Expr size = A_.width();
+        const Expr num_cols = B_.height();
+
+        // the elements of the triangle off the diagonal, r.x is the row and
+        // r.y the column
+        Var i("i"), j("j"), jo("jo");
+        RDom r(0, size, 0, size, "r");
+        if (lower_) {
+            r.where(r.x > r.y);
+        } else {
+            r.where(r.x < r.y);
+        }
+
+        Func product("product");
+        product(i, j) = select(unit_, B_(i, j), A_(i, i) * B_(i, j));
+        if (transpose_) {
+            product(r.y, j) += A_(r.x, r.y) * B_(r.x, j);
+        } else {
+            product(r.x, j) += A_(r.x, r.y) * B_(r.y, j);
+        }
+
+        // the columns of B are overwritten once their product is complete
+        output_(i, j) = a_ * product(i, j);
+
+        output_.split(j, jo, j, block_size_, TailStrategy::GuardWithIf);
+        if (parallel_) {
+            output_.parallel(jo);
+        }
+        product.compute_at(output_, jo);
+
+        if (vectorize_) {
+            output_.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            product.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            if (!transpose_) {
+                product.update().vectorize(r.x, vec_size, TailStrategy::GuardWithIf);
+            }
+        }
+
+        A_.dim(0).set_min(0).dim(1).set_min(0);
+        B_.dim(0).set_bounds(0, size).dim(1).set_min(0);
+        output_.dim(0).set_bounds(0, size).dim(1).set_bounds(0, num_cols);
+    }
+};
+
+// Generator class for the diagonal blocks of BLAS trsm (TRiangular Solve
+// with Multiple right hand sides) operations: solves op(A) * X = a * B in
+// place of B, with A upper or lower triangular, unit or non-unit. Each column
+// of B is solved like in TRSV, the columns are split into tasks of
+// block_size columns.
+template<class T>
+class TRSMGenerator : public Generator<TRSMGenerator<T>> {
+public:
+    typedef Generator<TRSMGenerator<T>> Base;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    using Base::target;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<bool> vectorize_ = {"vectorize", true};
+    GeneratorParam<bool> parallel_ = {"parallel", true};
+    GeneratorParam<int> block_size_ = {"block_size", 1 << 3};
+    GeneratorParam<bool> lower_ = {"lower", false};
+    GeneratorParam<bool> transpose_ = {"transpose", false};
+
+    Input<bool> unit_ = {"unit", false};
+    Input<T> a_ = {"a", 1};
+    Input<Buffer<T>> A_ = {"A", 2};
+    Input<Buffer<T>> B_ = {"B", 2};
+
+    Output<Buffer<T>> output_ = {"output", 2};
+
+    void generate() {
+        const int vec_size = vectorize_ ? natural_vector_size(type_of<T>()) : 1;
+        const Expr size = A_.width();
+        const Expr num_cols = B_.height();
+
+        auto diagonal = [&](Expr k) {
+            return select(unit_, cast<T>(1), A_(k, k));
+        };
+
+        // see TRSVGenerator, the unknowns are eliminated forwards if op(A)
+        // is lower triangular and backwards otherwise
+        const bool forward = static_cast<bool>(lower_) != static_cast<bool>(transpose_);
+
+        Var i("i"), j("j"), jo("jo");
+        RDom r(0, size, 0, size, "r");
+        Expr col = forward ? Expr(r.y) : size - 1 - r.y;
+        if (lower_) {
+            r.where(r.x > col);
+        } else {
+            r.where(r.x < col);
+        }
+
+        Func solution("solution");
+        solution(i, j) = a_ * B_(i, j);
+        if (transpose_) {
+            solution(col, j) -= A_(r.x, col) * (solution(r.x, j) / diagonal(r.x));
+        } else {
+            solution(r.x, j) -= A_(r.x, col) * (solution(col, j) / diagonal(col));
+        }
+
+        output_(i, j) = solution(i, j) / diagonal(i);
+
+        output_.split(j, jo, j, block_size_, TailStrategy::GuardWithIf);
+        if (parallel_) {
+            output_.parallel(jo);
+        }
+        solution.compute_at(output_, jo);
+
+        if (vectorize_) {
+            output_.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            solution.vectorize(i, vec_size, TailStrategy::GuardWithIf);
+            if (!transpose_) {
+                solution.update().vectorize(r.x, vec_size, TailStrategy::GuardWithIf);
+            }
+        }
+
+        A_.dim(0).set_min(0).dim(1).set_min(0);
+        B_.dim(0).set_bounds(0, size).dim(1).set_min(0);
+        output_.dim(0).set_bounds(0, size).dim(1).set_bounds(0, num_cols);
+    }
+};
+
 }  // namespace
 
 HALIDE_REGISTER_GENERATOR(GEMMGenerator<float>, sgemm)
 HALIDE_REGISTER_GENERATOR(GEMMGenerator<double>, dgemm)
+HALIDE_REGISTER_GENERATOR(BatchedGEMMGenerator<float>, sgemm_batched)
+HALIDE_REGISTER_GENERATOR(BatchedGEMMGenerator<double>, dgemm_batched)
+HALIDE_REGISTER_GENERATOR(TRMMGenerator<float>, strmm)
+HALIDE_REGISTER_GENERATOR(TRMMGenerator<double>, dtrmm)
+HALIDE_REGISTER_GENERATOR(TRSMGenerator<float>, strsm)
+HALIDE_REGISTER_GENERATOR(TRSMGenerator<double>, dtrsm)
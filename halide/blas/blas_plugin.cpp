@@ -24,3 +24,39 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(dger_plugin,
     phylanx_halide_plugin::blas::match_data[5]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(dgemm_plugin,
     phylanx_halide_plugin::blas::match_data[6]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(idamax_plugin,
+    phylanx_halide_plugin::blas::match_data[7]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dswap_plugin,
+    phylanx_halide_plugin::blas::match_data[8]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(daxpby_plugin,
+    phylanx_halide_plugin::blas::match_data[9]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(drot_plugin,
+    phylanx_halide_plugin::blas::match_data[10]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(drotm_plugin,
+    phylanx_halide_plugin::blas::match_data[11]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(drotg_plugin,
+    phylanx_halide_plugin::blas::match_data[12]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(drotmg_plugin,
+    phylanx_halide_plugin::blas::match_data[13]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dsymv_plugin,
+    phylanx_halide_plugin::blas::match_data[14]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dsyr_plugin,
+    phylanx_halide_plugin::blas::match_data[15]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dsyr2_plugin,
+    phylanx_halide_plugin::blas::match_data[16]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dtrmv_plugin,
+    phylanx_halide_plugin::blas::match_data[17]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dtrsv_plugin,
+    phylanx_halide_plugin::blas::match_data[18]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dsyrk_plugin,
+    phylanx_halide_plugin::blas::match_data[19]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dsyr2k_plugin,
+    phylanx_halide_plugin::blas::match_data[20]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dsymm_plugin,
+    phylanx_halide_plugin::blas::match_data[21]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dtrmm_plugin,
+    phylanx_halide_plugin::blas::match_data[22]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dtrsm_plugin,
+    phylanx_halide_plugin::blas::match_data[23]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dgemm_batched_plugin,
+    phylanx_halide_plugin::blas::match_data[24]);
@@ -1,5 +1,7 @@
 #include "halide_blas.h"
 #include "HalideBuffer.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string.h>
 
@@ -29,6 +31,408 @@ Buffer<T> init_matrix_buffer(const int M, const int N, T *A, const int lda) {
     return Buffer<T>(A, 2, shape);
 }
 
+template<typename T>
+Buffer<T> init_batch_buffer(const int M, const int N, T *A, const int lda,
+                            const int stride, const int batch_count) {
+    halide_dimension_t shape[] = {{0, M, 1}, {0, N, lda}, {0, batch_count, stride}};
+    return Buffer<T>(A, 3, shape);
+}
+
+// Construct the Givens rotation zeroing b in (a, b), following the reference
+// BLAS: on return a holds r and b the value z from which c and s can be
+// recovered.
+template<typename T>
+void rotg(T *a, T *b, T *c, T *s) {
+    const T roe = std::abs(*a) > std::abs(*b) ? *a : *b;
+    const T scale = std::abs(*a) + std::abs(*b);
+    if (scale == 0) {
+        *c = 1;
+        *s = 0;
+        *a = 0;
+        *b = 0;
+        return;
+    }
+
+    const T as = *a / scale;
+    const T bs = *b / scale;
+    const T r = std::copysign(scale * std::sqrt(as * as + bs * bs), roe);
+    *c = *a / r;
+    *s = *b / r;
+
+    T z = 1;
+    if (std::abs(*a) > std::abs(*b)) {
+        z = *s;
+    } else if (*c != 0) {
+        z = 1 / *c;
+    }
+    *a = r;
+    *b = z;
+}
+
+// Construct the modified Givens rotation zeroing the second component of
+// (sqrt(d1) * b1, sqrt(d2) * b2), following the reference BLAS. P receives
+// the flag and the elements of H not implied by it.
+template<typename T>
+void rotmg(T *d1, T *d2, T *b1, const T b2, T *P) {
+    const T gam = 4096;
+    const T gamsq = gam * gam;
+    const T rgamsq = 1 / gamsq;
+
+    T flag = 0;
+    T h11 = 0, h12 = 0, h21 = 0, h22 = 0;
+
+    // rescaling turns H into its full form
+    auto make_full = [&]() {
+        if (flag == 0) {
+            h11 = 1;
+            h22 = 1;
+        } else if (flag > 0) {
+            h21 = -1;
+            h12 = 1;
+        }
+        flag = -1;
+    };
+
+    if (*d1 < 0) {
+        flag = -1;
+        *d1 = 0;
+        *d2 = 0;
+        *b1 = 0;
+    } else {
+        const T p2 = *d2 * b2;
+        if (p2 == 0) {
+            P[0] = -2;
+            return;
+        }
+
+        const T p1 = *d1 * *b1;
+        const T q2 = p2 * b2;
+        const T q1 = p1 * *b1;
+
+        if (std::abs(q1) > std::abs(q2)) {
+            h21 = -b2 / *b1;
+            h12 = p2 / p1;
+            const T u = 1 - h12 * h21;
+            if (u > 0) {
+                flag = 0;
+                *d1 /= u;
+                *d2 /= u;
+                *b1 *= u;
+            } else {
+                flag = -1;
+                h11 = h12 = h21 = h22 = 0;
+                *d1 = 0;
+                *d2 = 0;
+                *b1 = 0;
+            }
+        } else if (q2 < 0) {
+            flag = -1;
+            h11 = h12 = h21 = h22 = 0;
+            *d1 = 0;
+            *d2 = 0;
+            *b1 = 0;
+        } else {
+            flag = 1;
+            h11 = p1 / p2;
+            h22 = *b1 / b2;
+            const T u = 1 + h11 * h22;
+            const T temp = *d2 / u;
+            *d2 = *d1 / u;
+            *d1 = temp;
+            *b1 = b2 * u;
+        }
+
+        if (*d1 != 0) {
+            while (*d1 <= rgamsq || *d1 >= gamsq) {
+                make_full();
+                if (*d1 <= rgamsq) {
+                    *d1 *= gamsq;
+                    *b1 /= gam;
+                    h11 /= gam;
+                    h12 /= gam;
+                } else {
+                    *d1 /= gamsq;
+                    *b1 *= gam;
+                    h11 *= gam;
+                    h12 *= gam;
+                }
+            }
+        }
+
+        if (*d2 != 0) {
+            while (std::abs(*d2) <= rgamsq || std::abs(*d2) >= gamsq) {
+                make_full();
+                if (std::abs(*d2) <= rgamsq) {
+                    *d2 *= gamsq;
+                    h21 /= gam;
+                    h22 /= gam;
+                } else {
+                    *d2 /= gamsq;
+                    h21 *= gam;
+                    h22 *= gam;
+                }
+            }
+        }
+    }
+
+    if (flag < 0) {
+        P[1] = h11;
+        P[2] = h21;
+        P[3] = h12;
+        P[4] = h22;
+    } else if (flag == 0) {
+        P[2] = h21;
+        P[3] = h12;
+    } else {
+        P[1] = h11;
+        P[4] = h22;
+    }
+    P[0] = flag;
+}
+
+// The symmetric and triangular level 3 operations are split into square blocks
+// of this size. GEMM runs on all blocks off the diagonal, which is where
+// almost all of the work is for large matrices.
+const int l3_block_size = 256;
+
+// The block [row, row + rows) x [col, col + cols) of A, indexed from zero.
+template<typename T>
+Buffer<T> block(const Buffer<T> &A, int row, int rows, int col, int cols) {
+    Buffer<T> view = A.cropped(0, row, rows).cropped(1, col, cols);
+    view.set_min(0, 0);
+    return view;
+}
+
+int gemm_kernel(bool transA, bool transB, float a, Buffer<float> A, Buffer<float> B, float b, Buffer<float> C) {
+    return halide_sgemm(transA, transB, a, A, B, b, C);
+}
+
+int gemm_kernel(bool transA, bool transB, double a, Buffer<double> A, Buffer<double> B, double b, Buffer<double> C) {
+    return halide_dgemm(transA, transB, a, A, B, b, C);
+}
+
+int trmm_kernel(bool lower, bool trans, bool unit, float a, Buffer<float> A, Buffer<float> B) {
+    return halide_strmm(lower, trans, unit, a, A, B);
+}
+
+int trmm_kernel(bool lower, bool trans, bool unit, double a, Buffer<double> A, Buffer<double> B) {
+    return halide_dtrmm(lower, trans, unit, a, A, B);
+}
+
+int trsm_kernel(bool lower, bool trans, bool unit, float a, Buffer<float> A, Buffer<float> B) {
+    return halide_strsm(lower, trans, unit, a, A, B);
+}
+
+int trsm_kernel(bool lower, bool trans, bool unit, double a, Buffer<double> A, Buffer<double> B) {
+    return halide_dtrsm(lower, trans, unit, a, A, B);
+}
+
+// C := a * op(A) * op(B)^T + b * C, plus a * op(B) * op(A)^T if two_sided is
+// set, on the stored triangle of C only. Diagonal blocks are computed into a
+// scratch block and merged, so that the other triangle is never written.
+template<typename T>
+int syr2k_blocked(bool lower, bool trans, bool two_sided, T a, Buffer<T> A, Buffer<T> B, T b, Buffer<T> C) {
+    const int n = C.dim(0).extent();
+    const int k = trans ? A.dim(0).extent() : A.dim(1).extent();
+    const int nb = l3_block_size;
+
+    // rows [i, i + size) of op(X)
+    auto rows = [&](const Buffer<T> &X, int i, int size) {
+        return trans ? block(X, 0, k, i, size) : block(X, i, size, 0, k);
+    };
+
+    for (int j = 0; j < n; j += nb) {
+        const int nj = std::min(nb, n - j);
+        const int i_begin = lower ? j : 0;
+        const int i_end = lower ? n : j + nj;
+        for (int i = i_begin; i < i_end; i += nb) {
+            const int ni = std::min(nb, n - i);
+            const bool diagonal = i == j;
+
+            Buffer<T> C_ij = diagonal ? Buffer<T>(ni, nj) : block(C, i, ni, j, nj);
+            if (diagonal) {
+                C_ij.fill(0);
+            }
+
+            int result = gemm_kernel(trans, !trans, a, rows(A, i, ni), rows(B, j, nj),
+                                     diagonal ? T(0) : b, C_ij);
+            if (result == 0 && two_sided) {
+                result = gemm_kernel(trans, !trans, a, rows(B, i, ni), rows(A, j, nj),
+                                     T(1), C_ij);
+            }
+            if (result != 0) {
+                return result;
+            }
+
+            if (diagonal) {
+                for (int jj = 0; jj < nj; ++jj) {
+                    const int first = lower ? jj : 0;
+                    const int last = lower ? ni : jj + 1;
+                    for (int ii = first; ii < last; ++ii) {
+                        C(i + ii, j + jj) = C_ij(ii, jj) + b * C(i + ii, j + jj);
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// C := a * A * B + b * C, or C := a * B * A + b * C if right is set, with only
+// the stored triangle of the symmetric A referenced. Blocks of the other
+// triangle are read as transposed blocks of the stored one, diagonal blocks
+// are expanded into a full scratch block.
+template<typename T>
+int symm_blocked(bool right, bool lower, T a, Buffer<T> A, Buffer<T> B, T b, Buffer<T> C) {
+    const int m = C.dim(0).extent();
+    const int n = C.dim(1).extent();
+    const int size = A.dim(0).extent();
+    const int nb = l3_block_size;
+
+    // block (p, q) of the symmetric matrix, stored transposed if transposed
+    // is set on return
+    auto sym_block = [&](int p, int np, int q, int nq, bool &transposed) {
+        transposed = false;
+        if (p == q) {
+            Buffer<T> full(np, np);
+            for (int jj = 0; jj < np; ++jj) {
+                for (int ii = 0; ii < np; ++ii) {
+                    const bool stored = lower ? ii >= jj : ii <= jj;
+                    full(ii, jj) = stored ? A(p + ii, p + jj) : A(p + jj, p + ii);
+                }
+            }
+            return full;
+        }
+        if ((p > q) == lower) {
+            return block(A, p, np, q, nq);
+        }
+        transposed = true;
+        return block(A, q, nq, p, np);
+    };
+
+    for (int o = 0; o < size; o += nb) {
+        const int no = std::min(nb, size - o);
+        for (int k = 0; k < size; k += nb) {
+            const int nk = std::min(nb, size - k);
+            const T beta = k == 0 ? b : T(1);
+
+            bool transposed;
+            int result;
+            if (right) {
+                Buffer<T> A_ko = sym_block(k, nk, o, no, transposed);
+                result = gemm_kernel(false, transposed, a, block(B, 0, m, k, nk), A_ko,
+                                     beta, block(C, 0, m, o, no));
+            } else {
+                Buffer<T> A_ok = sym_block(o, no, k, nk, transposed);
+                result = gemm_kernel(transposed, false, a, A_ok, block(B, k, nk, 0, n),
+                                     beta, block(C, o, no, 0, n));
+            }
+            if (result != 0) {
+                return result;
+            }
+        }
+    }
+    return 0;
+}
+
+// B := a * op(A) * B. Each block row of B is overwritten while the block rows
+// it still depends on are unmodified: from the bottom if op(A) is lower
+// triangular, from the top otherwise.
+template<typename T>
+int trmm_left(bool lower, bool trans, bool unit, T a, Buffer<T> A, Buffer<T> B) {
+    const int m = B.dim(0).extent();
+    const int n = B.dim(1).extent();
+    const int nb = l3_block_size;
+    const int blocks = (m + nb - 1) / nb;
+    const bool op_lower = lower != trans;
+
+    for (int step = 0; step < blocks; ++step) {
+        const int i = (op_lower ? blocks - 1 - step : step) * nb;
+        const int ni = std::min(nb, m - i);
+        Buffer<T> B_i = block(B, i, ni, 0, n);
+
+        int result = trmm_kernel(lower, trans, unit, a, block(A, i, ni, i, ni), B_i);
+
+        // the blocks of op(A) before or after the diagonal block
+        const int k = op_lower ? 0 : i + ni;
+        const int nk = op_lower ? i : m - i - ni;
+        if (result == 0 && nk > 0) {
+            result = gemm_kernel(trans, false, a,
+                                 trans ? block(A, k, nk, i, ni) : block(A, i, ni, k, nk),
+                                 block(B, k, nk, 0, n), T(1), B_i);
+        }
+        if (result != 0) {
+            return result;
+        }
+    }
+    return 0;
+}
+
+// Solves op(A) * X = a * B in place of B. Each diagonal block is solved and
+// then eliminated from all block rows still to come by a GEMM update, a is
+// applied to all of B along with the first block.
+template<typename T>
+int trsm_left(bool lower, bool trans, bool unit, T a, Buffer<T> A, Buffer<T> B) {
+    const int m = B.dim(0).extent();
+    const int n = B.dim(1).extent();
+    const int nb = l3_block_size;
+    const int blocks = (m + nb - 1) / nb;
+    const bool forward = lower != trans;
+
+    for (int step = 0; step < blocks; ++step) {
+        const int i = (forward ? step : blocks - 1 - step) * nb;
+        const int ni = std::min(nb, m - i);
+        const T scale = step == 0 ? a : T(1);
+        Buffer<T> B_i = block(B, i, ni, 0, n);
+
+        int result = trsm_kernel(lower, trans, unit, scale, block(A, i, ni, i, ni), B_i);
+
+        // the unsolved block rows
+        const int k = forward ? i + ni : 0;
+        const int nk = forward ? m - i - ni : i;
+        if (result == 0 && nk > 0) {
+            result = gemm_kernel(trans, false, T(-1),
+                                 trans ? block(A, i, ni, k, nk) : block(A, k, nk, i, ni),
+                                 B_i, scale, block(B, k, nk, 0, n));
+        }
+        if (result != 0) {
+            return result;
+        }
+    }
+    return 0;
+}
+
+// B * op(A) is the transpose of op(A)^T * B^T, so the right-sided operations
+// run on a transposed copy of B.
+template<typename T, typename Left>
+int on_transposed(Buffer<T> B, Left left) {
+    Buffer<T> Bt(B.dim(1).extent(), B.dim(0).extent());
+    Bt.copy_from(B.transposed(0, 1));
+    const int result = left(Bt);
+    B.copy_from(Bt.transposed(0, 1));
+    return result;
+}
+
+template<typename T>
+int trmm_blocked(bool right, bool lower, bool trans, bool unit, T a, Buffer<T> A, Buffer<T> B) {
+    if (!right) {
+        return trmm_left(lower, trans, unit, a, A, B);
+    }
+    return on_transposed(B, [&](Buffer<T> Bt) {
+        return trmm_left(lower, !trans, unit, a, A, Bt);
+    });
+}
+
+template<typename T>
+int trsm_blocked(bool right, bool lower, bool trans, bool unit, T a, Buffer<T> A, Buffer<T> B) {
+    if (!right) {
+        return trsm_left(lower, trans, unit, a, A, B);
+    }
+    return on_transposed(B, [&](Buffer<T> Bt) {
+        return trsm_left(lower, !trans, unit, a, A, Bt);
+    });
+}
+
 }  // namespace
 
 #ifdef __cplusplus
@@ -53,6 +457,24 @@ void hblas_dcopy(const int N, const double *x, const int incx,
     assert_no_error(halide_dcopy(buff_x, buff_y));
 }
 
+//////////
+// swap //
+//////////
+
+void hblas_sswap(const int N, float *x, const int incx,
+                 float *y, const int incy) {
+    auto buff_x = init_vector_buffer(N, x, incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_sswap(buff_x, buff_y));
+}
+
+void hblas_dswap(const int N, double *x, const int incx,
+                 double *y, const int incy) {
+    auto buff_x = init_vector_buffer(N, x, incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_dswap(buff_x, buff_y));
+}
+
 //////////
 // scal //
 //////////
@@ -85,6 +507,72 @@ void hblas_daxpy(const int N, const double a, const double *x, const int incx,
     assert_no_error(halide_daxpy(a, buff_x, buff_y));
 }
 
+///////////
+// axpby //
+///////////
+
+void hblas_saxpby(const int N, const float a, const float *x, const int incx,
+                  const float b, float *y, const int incy) {
+    auto buff_x = init_vector_buffer(N, const_cast<float *>(x), incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_saxpby(a, buff_x, b, buff_y));
+}
+
+void hblas_daxpby(const int N, const double a, const double *x, const int incx,
+                  const double b, double *y, const int incy) {
+    auto buff_x = init_vector_buffer(N, const_cast<double *>(x), incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_daxpby(a, buff_x, b, buff_y));
+}
+
+//////////
+// rot  //
+//////////
+
+void hblas_srotg(float *a, float *b, float *c, float *s) {
+    rotg(a, b, c, s);
+}
+
+void hblas_drotg(double *a, double *b, double *c, double *s) {
+    rotg(a, b, c, s);
+}
+
+void hblas_srotmg(float *d1, float *d2, float *b1, const float b2, float *P) {
+    rotmg(d1, d2, b1, b2, P);
+}
+
+void hblas_drotmg(double *d1, double *d2, double *b1, const double b2, double *P) {
+    rotmg(d1, d2, b1, b2, P);
+}
+
+void hblas_srot(const int N, float *x, const int incx,
+                float *y, const int incy, const float c, const float s) {
+    auto buff_x = init_vector_buffer(N, x, incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_srot(buff_x, buff_y, c, s));
+}
+
+void hblas_drot(const int N, double *x, const int incx,
+                double *y, const int incy, const double c, const double s) {
+    auto buff_x = init_vector_buffer(N, x, incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_drot(buff_x, buff_y, c, s));
+}
+
+void hblas_srotm(const int N, float *x, const int incx,
+                 float *y, const int incy, const float *P) {
+    auto buff_x = init_vector_buffer(N, x, incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_srotm(buff_x, buff_y, P));
+}
+
+void hblas_drotm(const int N, double *x, const int incx,
+                 double *y, const int incy, const double *P) {
+    auto buff_x = init_vector_buffer(N, x, incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+    assert_no_error(halide_drotm(buff_x, buff_y, P));
+}
+
 //////////
 // dot  //
 //////////
@@ -117,16 +605,16 @@ float hblas_snrm2(const int N, const float *x, const int incx) {
     float result;
     auto buff_x = init_vector_buffer(N, const_cast<float *>(x), incx);
     auto buff_nrm = init_scalar_buffer(&result);
-    assert_no_error(halide_sdot(buff_x, buff_x, buff_nrm));
-    return std::sqrt(result);
+    assert_no_error(halide_snrm2(buff_x, buff_nrm));
+    return result;
 }
 
 double hblas_dnrm2(const int N, const double *x, const int incx) {
     double result;
     auto buff_x = init_vector_buffer(N, const_cast<double *>(x), incx);
     auto buff_nrm = init_scalar_buffer(&result);
-    assert_no_error(halide_ddot(buff_x, buff_x, buff_nrm));
-    return std::sqrt(result);
+    assert_no_error(halide_dnrm2(buff_x, buff_nrm));
+    return result;
 }
 
 //////////
@@ -149,6 +637,26 @@ double hblas_dasum(const int N, const double *x, const int incx) {
     return result;
 }
 
+///////////
+// iamax //
+///////////
+
+HBLAS_INDEX hblas_isamax(const int N, const float *x, const int incx) {
+    int32_t result;
+    auto buff_x = init_vector_buffer(N, const_cast<float *>(x), incx);
+    auto buff_max = init_scalar_buffer(&result);
+    assert_no_error(halide_isamax(buff_x, buff_max));
+    return result;
+}
+
+HBLAS_INDEX hblas_idamax(const int N, const double *x, const int incx) {
+    int32_t result;
+    auto buff_x = init_vector_buffer(N, const_cast<double *>(x), incx);
+    auto buff_max = init_scalar_buffer(&result);
+    assert_no_error(halide_idamax(buff_x, buff_max));
+    return result;
+}
+
 //////////
 // gemv //
 //////////
@@ -219,6 +727,120 @@ void hblas_dger(const enum HBLAS_ORDER order, const int M, const int N,
     assert_no_error(halide_dger(alpha, buff_x, buff_y, buff_A));
 }
 
+//////////
+// symv //
+//////////
+
+void hblas_ssymv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const float a, const float *A, const int lda,
+                 const float *x, const int incx, const float b, float *y, const int incy) {
+    auto buff_A = init_matrix_buffer(N, N, const_cast<float *>(A), lda);
+    auto buff_x = init_vector_buffer(N, const_cast<float *>(x), incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+
+    assert_no_error(halide_ssymv(Uplo == HblasLower, a, buff_A, buff_x, b, buff_y));
+}
+
+void hblas_dsymv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const double a, const double *A, const int lda,
+                 const double *x, const int incx, const double b, double *y, const int incy) {
+    auto buff_A = init_matrix_buffer(N, N, const_cast<double *>(A), lda);
+    auto buff_x = init_vector_buffer(N, const_cast<double *>(x), incx);
+    auto buff_y = init_vector_buffer(N, y, incy);
+
+    assert_no_error(halide_dsymv(Uplo == HblasLower, a, buff_A, buff_x, b, buff_y));
+}
+
+//////////
+// syr  //
+//////////
+
+void hblas_ssyr(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                const int N, const float a, const float *x, const int incx,
+                float *A, const int lda) {
+    auto buff_x = init_vector_buffer(N, const_cast<float *>(x), incx);
+    auto buff_A = init_matrix_buffer(N, N, A, lda);
+
+    assert_no_error(halide_ssyr(Uplo == HblasLower, a, buff_x, buff_A));
+}
+
+void hblas_dsyr(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                const int N, const double a, const double *x, const int incx,
+                double *A, const int lda) {
+    auto buff_x = init_vector_buffer(N, const_cast<double *>(x), incx);
+    auto buff_A = init_matrix_buffer(N, N, A, lda);
+
+    assert_no_error(halide_dsyr(Uplo == HblasLower, a, buff_x, buff_A));
+}
+
+void hblas_ssyr2(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const float a, const float *x, const int incx,
+                 const float *y, const int incy, float *A, const int lda) {
+    auto buff_x = init_vector_buffer(N, const_cast<float *>(x), incx);
+    auto buff_y = init_vector_buffer(N, const_cast<float *>(y), incy);
+    auto buff_A = init_matrix_buffer(N, N, A, lda);
+
+    assert_no_error(halide_ssyr2(Uplo == HblasLower, a, buff_x, buff_y, buff_A));
+}
+
+void hblas_dsyr2(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const double a, const double *x, const int incx,
+                 const double *y, const int incy, double *A, const int lda) {
+    auto buff_x = init_vector_buffer(N, const_cast<double *>(x), incx);
+    auto buff_y = init_vector_buffer(N, const_cast<double *>(y), incy);
+    auto buff_A = init_matrix_buffer(N, N, A, lda);
+
+    assert_no_error(halide_dsyr2(Uplo == HblasLower, a, buff_x, buff_y, buff_A));
+}
+
+//////////
+// trmv //
+//////////
+
+void hblas_strmv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE trans, const enum HBLAS_DIAG Diag,
+                 const int N, const float *A, const int lda, float *x, const int incx) {
+    auto buff_A = init_matrix_buffer(N, N, const_cast<float *>(A), lda);
+    auto buff_x = init_vector_buffer(N, x, incx);
+
+    assert_no_error(halide_strmv(Uplo == HblasLower, trans != HblasNoTrans,
+                                 Diag == HblasUnit, buff_A, buff_x));
+}
+
+void hblas_dtrmv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE trans, const enum HBLAS_DIAG Diag,
+                 const int N, const double *A, const int lda, double *x, const int incx) {
+    auto buff_A = init_matrix_buffer(N, N, const_cast<double *>(A), lda);
+    auto buff_x = init_vector_buffer(N, x, incx);
+
+    assert_no_error(halide_dtrmv(Uplo == HblasLower, trans != HblasNoTrans,
+                                 Diag == HblasUnit, buff_A, buff_x));
+}
+
+//////////
+// trsv //
+//////////
+
+void hblas_strsv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE trans, const enum HBLAS_DIAG Diag,
+                 const int N, const float *A, const int lda, float *x, const int incx) {
+    auto buff_A = init_matrix_buffer(N, N, const_cast<float *>(A), lda);
+    auto buff_x = init_vector_buffer(N, x, incx);
+
+    assert_no_error(halide_strsv(Uplo == HblasLower, trans != HblasNoTrans,
+                                 Diag == HblasUnit, buff_A, buff_x));
+}
+
+void hblas_dtrsv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE trans, const enum HBLAS_DIAG Diag,
+                 const int N, const double *A, const int lda, double *x, const int incx) {
+    auto buff_A = init_matrix_buffer(N, N, const_cast<double *>(A), lda);
+    auto buff_x = init_vector_buffer(N, x, incx);
+
+    assert_no_error(halide_dtrsv(Uplo == HblasLower, trans != HblasNoTrans,
+                                 Diag == HblasUnit, buff_A, buff_x));
+}
+
 //////////
 // gemm //
 //////////
@@ -289,6 +911,182 @@ void hblas_dgemm(const enum HBLAS_ORDER Order, const enum HBLAS_TRANSPOSE TransA
     assert_no_error(halide_dgemm(tA, tB, alpha, buff_A, buff_B, beta, buff_C));
 }
 
+void hblas_sgemm_strided_batched(const enum HBLAS_ORDER Order, const enum HBLAS_TRANSPOSE TransA,
+                                 const enum HBLAS_TRANSPOSE TransB, const int M, const int N,
+                                 const int K, const float alpha, const float *A,
+                                 const int lda, const int strideA, const float *B,
+                                 const int ldb, const int strideB, const float beta,
+                                 float *C, const int ldc, const int strideC,
+                                 const int batch_count) {
+    const bool tA = TransA != HblasNoTrans;
+    const bool tB = TransB != HblasNoTrans;
+
+    auto buff_A = init_batch_buffer(tA ? K : M, tA ? M : K, const_cast<float *>(A), lda, strideA, batch_count);
+    auto buff_B = init_batch_buffer(tB ? N : K, tB ? K : N, const_cast<float *>(B), ldb, strideB, batch_count);
+    auto buff_C = init_batch_buffer(M, N, C, ldc, strideC, batch_count);
+
+    assert_no_error(halide_sgemm_batched(tA, tB, alpha, buff_A, buff_B, beta, buff_C));
+}
+
+void hblas_dgemm_strided_batched(const enum HBLAS_ORDER Order, const enum HBLAS_TRANSPOSE TransA,
+                                 const enum HBLAS_TRANSPOSE TransB, const int M, const int N,
+                                 const int K, const double alpha, const double *A,
+                                 const int lda, const int strideA, const double *B,
+                                 const int ldb, const int strideB, const double beta,
+                                 double *C, const int ldc, const int strideC,
+                                 const int batch_count) {
+    const bool tA = TransA != HblasNoTrans;
+    const bool tB = TransB != HblasNoTrans;
+
+    auto buff_A = init_batch_buffer(tA ? K : M, tA ? M : K, const_cast<double *>(A), lda, strideA, batch_count);
+    auto buff_B = init_batch_buffer(tB ? N : K, tB ? K : N, const_cast<double *>(B), ldb, strideB, batch_count);
+    auto buff_C = init_batch_buffer(M, N, C, ldc, strideC, batch_count);
+
+    assert_no_error(halide_dgemm_batched(tA, tB, alpha, buff_A, buff_B, beta, buff_C));
+}
+
+//////////
+// syrk //
+//////////
+
+void hblas_ssyrk(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                 const float alpha, const float *A, const int lda,
+                 const float beta, float *C, const int ldc) {
+    const bool trans = Trans != HblasNoTrans;
+    auto buff_A = init_matrix_buffer(trans ? K : N, trans ? N : K, const_cast<float *>(A), lda);
+    auto buff_C = init_matrix_buffer(N, N, C, ldc);
+
+    assert_no_error(syr2k_blocked(Uplo == HblasLower, trans, false, alpha, buff_A, buff_A, beta, buff_C));
+}
+
+void hblas_dsyrk(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                 const double alpha, const double *A, const int lda,
+                 const double beta, double *C, const int ldc) {
+    const bool trans = Trans != HblasNoTrans;
+    auto buff_A = init_matrix_buffer(trans ? K : N, trans ? N : K, const_cast<double *>(A), lda);
+    auto buff_C = init_matrix_buffer(N, N, C, ldc);
+
+    assert_no_error(syr2k_blocked(Uplo == HblasLower, trans, false, alpha, buff_A, buff_A, beta, buff_C));
+}
+
+void hblas_ssyr2k(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                  const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                  const float alpha, const float *A, const int lda,
+                  const float *B, const int ldb, const float beta,
+                  float *C, const int ldc) {
+    const bool trans = Trans != HblasNoTrans;
+    auto buff_A = init_matrix_buffer(trans ? K : N, trans ? N : K, const_cast<float *>(A), lda);
+    auto buff_B = init_matrix_buffer(trans ? K : N, trans ? N : K, const_cast<float *>(B), ldb);
+    auto buff_C = init_matrix_buffer(N, N, C, ldc);
+
+    assert_no_error(syr2k_blocked(Uplo == HblasLower, trans, true, alpha, buff_A, buff_B, beta, buff_C));
+}
+
+void hblas_dsyr2k(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                  const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                  const double alpha, const double *A, const int lda,
+                  const double *B, const int ldb, const double beta,
+                  double *C, const int ldc) {
+    const bool trans = Trans != HblasNoTrans;
+    auto buff_A = init_matrix_buffer(trans ? K : N, trans ? N : K, const_cast<double *>(A), lda);
+    auto buff_B = init_matrix_buffer(trans ? K : N, trans ? N : K, const_cast<double *>(B), ldb);
+    auto buff_C = init_matrix_buffer(N, N, C, ldc);
+
+    assert_no_error(syr2k_blocked(Uplo == HblasLower, trans, true, alpha, buff_A, buff_B, beta, buff_C));
+}
+
+//////////
+// symm //
+//////////
+
+void hblas_ssymm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const int M, const int N,
+                 const float alpha, const float *A, const int lda,
+                 const float *B, const int ldb, const float beta,
+                 float *C, const int ldc) {
+    const bool right = Side == HblasRight;
+    auto buff_A = init_matrix_buffer(right ? N : M, right ? N : M, const_cast<float *>(A), lda);
+    auto buff_B = init_matrix_buffer(M, N, const_cast<float *>(B), ldb);
+    auto buff_C = init_matrix_buffer(M, N, C, ldc);
+
+    assert_no_error(symm_blocked(right, Uplo == HblasLower, alpha, buff_A, buff_B, beta, buff_C));
+}
+
+void hblas_dsymm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const int M, const int N,
+                 const double alpha, const double *A, const int lda,
+                 const double *B, const int ldb, const double beta,
+                 double *C, const int ldc) {
+    const bool right = Side == HblasRight;
+    auto buff_A = init_matrix_buffer(right ? N : M, right ? N : M, const_cast<double *>(A), lda);
+    auto buff_B = init_matrix_buffer(M, N, const_cast<double *>(B), ldb);
+    auto buff_C = init_matrix_buffer(M, N, C, ldc);
+
+    assert_no_error(symm_blocked(right, Uplo == HblasLower, alpha, buff_A, buff_B, beta, buff_C));
+}
+
+//////////
+// trmm //
+//////////
+
+void hblas_strmm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const float alpha, const float *A, const int lda,
+                 float *B, const int ldb) {
+    const bool right = Side == HblasRight;
+    auto buff_A = init_matrix_buffer(right ? N : M, right ? N : M, const_cast<float *>(A), lda);
+    auto buff_B = init_matrix_buffer(M, N, B, ldb);
+
+    assert_no_error(trmm_blocked(right, Uplo == HblasLower, TransA != HblasNoTrans,
+                                 Diag == HblasUnit, alpha, buff_A, buff_B));
+}
+
+void hblas_dtrmm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const double alpha, const double *A, const int lda,
+                 double *B, const int ldb) {
+    const bool right = Side == HblasRight;
+    auto buff_A = init_matrix_buffer(right ? N : M, right ? N : M, const_cast<double *>(A), lda);
+    auto buff_B = init_matrix_buffer(M, N, B, ldb);
+
+    assert_no_error(trmm_blocked(right, Uplo == HblasLower, TransA != HblasNoTrans,
+                                 Diag == HblasUnit, alpha, buff_A, buff_B));
+}
+
+//////////
+// trsm //
+//////////
+
+void hblas_strsm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const float alpha, const float *A, const int lda,
+                 float *B, const int ldb) {
+    const bool right = Side == HblasRight;
+    auto buff_A = init_matrix_buffer(right ? N : M, right ? N : M, const_cast<float *>(A), lda);
+    auto buff_B = init_matrix_buffer(M, N, B, ldb);
+
+    assert_no_error(trsm_blocked(right, Uplo == HblasLower, TransA != HblasNoTrans,
+                                 Diag == HblasUnit, alpha, buff_A, buff_B));
+}
+
+void hblas_dtrsm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const double alpha, const double *A, const int lda,
+                 double *B, const int ldb) {
+    const bool right = Side == HblasRight;
+    auto buff_A = init_matrix_buffer(right ? N : M, right ? N : M, const_cast<double *>(A), lda);
+    auto buff_B = init_matrix_buffer(M, N, B, ldb);
+
+    assert_no_error(trsm_blocked(right, Uplo == HblasLower, TransA != HblasNoTrans,
+                                 Diag == HblasUnit, alpha, buff_A, buff_B));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,32 +2,119 @@
 #define HALIDE_BLAS_H
 
 #include <cmath>
+#include <cstddef>
 
 #include "HalideRuntime.h"
-#include "halide_dasum.h"
+#include "halide_dasum_impl.h"
+#include "halide_dasum_par.h"
+#include "halide_daxpby_impl.h"
+#include "halide_daxpby_par.h"
 #include "halide_daxpy_impl.h"
 #include "halide_dcopy_impl.h"
-#include "halide_ddot.h"
+#include "halide_ddot_impl.h"
+#include "halide_ddot_par.h"
+#include "halide_dgemm_batched_notrans.h"
+#include "halide_dgemm_batched_transA.h"
+#include "halide_dgemm_batched_transAB.h"
+#include "halide_dgemm_batched_transB.h"
 #include "halide_dgemm_notrans.h"
 #include "halide_dgemm_transA.h"
 #include "halide_dgemm_transAB.h"
 #include "halide_dgemm_transB.h"
 #include "halide_dgemv_notrans.h"
+#include "halide_dgemv_notrans_par.h"
 #include "halide_dgemv_trans.h"
+#include "halide_dgemv_trans_par.h"
 #include "halide_dger_impl.h"
+#include "halide_dger_impl_par.h"
+#include "halide_dnrm2_impl.h"
+#include "halide_dnrm2_par.h"
+#include "halide_drot_impl.h"
+#include "halide_drot_par.h"
 #include "halide_dscal_impl.h"
-#include "halide_sasum.h"
+#include "halide_dswap_impl.h"
+#include "halide_dswap_par.h"
+#include "halide_dsymv_lower.h"
+#include "halide_dsymv_lower_par.h"
+#include "halide_dsymv_upper.h"
+#include "halide_dsymv_upper_par.h"
+#include "halide_dsyr2_lower.h"
+#include "halide_dsyr2_upper.h"
+#include "halide_dsyr_lower.h"
+#include "halide_dsyr_upper.h"
+#include "halide_dtrmm_lower_notrans.h"
+#include "halide_dtrmm_lower_trans.h"
+#include "halide_dtrmm_upper_notrans.h"
+#include "halide_dtrmm_upper_trans.h"
+#include "halide_dtrmv_lower_notrans.h"
+#include "halide_dtrmv_lower_trans.h"
+#include "halide_dtrmv_upper_notrans.h"
+#include "halide_dtrmv_upper_trans.h"
+#include "halide_dtrsm_lower_notrans.h"
+#include "halide_dtrsm_lower_trans.h"
+#include "halide_dtrsm_upper_notrans.h"
+#include "halide_dtrsm_upper_trans.h"
+#include "halide_dtrsv_lower_notrans.h"
+#include "halide_dtrsv_lower_trans.h"
+#include "halide_dtrsv_upper_notrans.h"
+#include "halide_dtrsv_upper_trans.h"
+#include "halide_idamax_impl.h"
+#include "halide_idamax_par.h"
+#include "halide_isamax_impl.h"
+#include "halide_isamax_par.h"
+#include "halide_sasum_impl.h"
+#include "halide_sasum_par.h"
+#include "halide_saxpby_impl.h"
+#include "halide_saxpby_par.h"
 #include "halide_saxpy_impl.h"
 #include "halide_scopy_impl.h"
-#include "halide_sdot.h"
+#include "halide_sdot_impl.h"
+#include "halide_sdot_par.h"
+#include "halide_sgemm_batched_notrans.h"
+#include "halide_sgemm_batched_transA.h"
+#include "halide_sgemm_batched_transAB.h"
+#include "halide_sgemm_batched_transB.h"
 #include "halide_sgemm_notrans.h"
 #include "halide_sgemm_transA.h"
 #include "halide_sgemm_transAB.h"
 #include "halide_sgemm_transB.h"
 #include "halide_sgemv_notrans.h"
+#include "halide_sgemv_notrans_par.h"
 #include "halide_sgemv_trans.h"
+#include "halide_sgemv_trans_par.h"
 #include "halide_sger_impl.h"
+#include "halide_sger_impl_par.h"
+#include "halide_snrm2_impl.h"
+#include "halide_snrm2_par.h"
+#include "halide_srot_impl.h"
+#include "halide_srot_par.h"
 #include "halide_sscal_impl.h"
+#include "halide_sswap_impl.h"
+#include "halide_sswap_par.h"
+#include "halide_ssymv_lower.h"
+#include "halide_ssymv_lower_par.h"
+#include "halide_ssymv_upper.h"
+#include "halide_ssymv_upper_par.h"
+#include "halide_ssyr2_lower.h"
+#include "halide_ssyr2_upper.h"
+#include "halide_ssyr_lower.h"
+#include "halide_ssyr_upper.h"
+#include "halide_strmm_lower_notrans.h"
+#include "halide_strmm_lower_trans.h"
+#include "halide_strmm_upper_notrans.h"
+#include "halide_strmm_upper_trans.h"
+#include "halide_strmv_lower_notrans.h"
+#include "halide_strmv_lower_trans.h"
+#include "halide_strmv_upper_notrans.h"
+#include "halide_strmv_upper_trans.h"
+#include "halide_strsm_lower_notrans.h"
+#include "halide_strsm_lower_trans.h"
+#include "halide_strsm_upper_notrans.h"
+#include "halide_strsm_upper_trans.h"
+#include "halide_strsv_lower_notrans.h"
+#include "halide_strsv_lower_trans.h"
+#include "halide_strsv_upper_notrans.h"
+#include "halide_strsv_upper_trans.h"
 
 inline int halide_scopy(halide_buffer_t *x, halide_buffer_t *y) {
     return halide_scopy_impl(0, x, nullptr, y);
@@ -53,30 +140,261 @@ inline int halide_daxpy(double a, halide_buffer_t *x, halide_buffer_t *y) {
     return halide_daxpy_impl(a, x, y, y);
 }
 
+// Reductions over vectors with at least this many elements run the parallel
+// kernels. These combine the partial sums of fixed size chunks in the order
+// of the chunks, the result doesn't depend on the number of threads.
+const long long hblas_parallel_l1_threshold = 1LL << 20;
+
+inline bool hblas_use_parallel_l1(const halide_buffer_t *x) {
+    return (long long)x->dim[0].extent >= hblas_parallel_l1_threshold;
+}
+
+inline int halide_sdot(halide_buffer_t *x, halide_buffer_t *y, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_sdot_par(x, y, result);
+    }
+    return halide_sdot_impl(x, y, result);
+}
+
+inline int halide_ddot(halide_buffer_t *x, halide_buffer_t *y, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_ddot_par(x, y, result);
+    }
+    return halide_ddot_impl(x, y, result);
+}
+
+inline int halide_sasum(halide_buffer_t *x, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_sasum_par(x, result);
+    }
+    return halide_sasum_impl(x, result);
+}
+
+inline int halide_dasum(halide_buffer_t *x, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_dasum_par(x, result);
+    }
+    return halide_dasum_impl(x, result);
+}
+
+inline int halide_snrm2(halide_buffer_t *x, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_snrm2_par(x, result);
+    }
+    return halide_snrm2_impl(x, result);
+}
+
+inline int halide_dnrm2(halide_buffer_t *x, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_dnrm2_par(x, result);
+    }
+    return halide_dnrm2_impl(x, result);
+}
+
+inline int halide_isamax(halide_buffer_t *x, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_isamax_par(x, result);
+    }
+    return halide_isamax_impl(x, result);
+}
+
+inline int halide_idamax(halide_buffer_t *x, halide_buffer_t *result) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_idamax_par(x, result);
+    }
+    return halide_idamax_impl(x, result);
+}
+
+inline int halide_saxpby(float a, halide_buffer_t *x, float b, halide_buffer_t *y) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_saxpby_par(a, x, b, y, y);
+    }
+    return halide_saxpby_impl(a, x, b, y, y);
+}
+
+inline int halide_daxpby(double a, halide_buffer_t *x, double b, halide_buffer_t *y) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_daxpby_par(a, x, b, y, y);
+    }
+    return halide_daxpby_impl(a, x, b, y, y);
+}
+
+inline int halide_sswap(halide_buffer_t *x, halide_buffer_t *y) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_sswap_par(x, y, x, y);
+    }
+    return halide_sswap_impl(x, y, x, y);
+}
+
+inline int halide_dswap(halide_buffer_t *x, halide_buffer_t *y) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_dswap_par(x, y, x, y);
+    }
+    return halide_dswap_impl(x, y, x, y);
+}
+
+// Apply H = [h11 h12; h21 h22] to the pairs (x(i), y(i)).
+inline int halide_srot2(halide_buffer_t *x, halide_buffer_t *y, float h11, float h21, float h12, float h22) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_srot_par(x, y, h11, h21, h12, h22, x, y);
+    }
+    return halide_srot_impl(x, y, h11, h21, h12, h22, x, y);
+}
+
+inline int halide_drot2(halide_buffer_t *x, halide_buffer_t *y, double h11, double h21, double h12, double h22) {
+    if (hblas_use_parallel_l1(x)) {
+        return halide_drot_par(x, y, h11, h21, h12, h22, x, y);
+    }
+    return halide_drot_impl(x, y, h11, h21, h12, h22, x, y);
+}
+
+inline int halide_srot(halide_buffer_t *x, halide_buffer_t *y, float c, float s) {
+    return halide_srot2(x, y, c, -s, s, c);
+}
+
+inline int halide_drot(halide_buffer_t *x, halide_buffer_t *y, double c, double s) {
+    return halide_drot2(x, y, c, -s, s, c);
+}
+
+// The modified rotation is given by its flag P[0] and the elements of H not
+// implied by the flag, -2 denotes the identity.
+inline int halide_srotm(halide_buffer_t *x, halide_buffer_t *y, const float *P) {
+    const float flag = P[0];
+    if (flag == -2) {
+        return 0;
+    }
+    return halide_srot2(x, y, flag == 0 ? 1 : P[1], flag == 1 ? -1 : P[2],
+                        flag == 1 ? 1 : P[3], flag == 0 ? 1 : P[4]);
+}
+
+inline int halide_drotm(halide_buffer_t *x, halide_buffer_t *y, const double *P) {
+    const double flag = P[0];
+    if (flag == -2) {
+        return 0;
+    }
+    return halide_drot2(x, y, flag == 0 ? 1 : P[1], flag == 1 ? -1 : P[2],
+                        flag == 1 ? 1 : P[3], flag == 0 ? 1 : P[4]);
+}
+
+// Level 2 operations on matrices with at least this many elements run the
+// parallel kernels. Below, the matrix fits into the caches and spawning the
+// tasks costs more than the memory bandwidth of the other cores gains.
+const long long hblas_parallel_l2_threshold = 1LL << 18;
+
+inline bool hblas_use_parallel_l2(const halide_buffer_t *A) {
+    return (long long)A->dim[0].extent * A->dim[1].extent >= hblas_parallel_l2_threshold;
+}
+
 inline int halide_sgemv(bool trans, float a, halide_buffer_t *A, halide_buffer_t *x, float b, halide_buffer_t *y) {
+    const bool parallel = hblas_use_parallel_l2(A);
     if (trans) {
-        return halide_sgemv_trans(a, A, x, b, y, y);
+        return parallel ? halide_sgemv_trans_par(a, A, x, b, y, y) : halide_sgemv_trans(a, A, x, b, y, y);
     } else {
-        return halide_sgemv_notrans(a, A, x, b, y, y);
+        return parallel ? halide_sgemv_notrans_par(a, A, x, b, y, y) : halide_sgemv_notrans(a, A, x, b, y, y);
     }
 }
 
 inline int halide_dgemv(bool trans, double a, halide_buffer_t *A, halide_buffer_t *x, double b, halide_buffer_t *y) {
+    const bool parallel = hblas_use_parallel_l2(A);
     if (trans) {
-        return halide_dgemv_trans(a, A, x, b, y, y);
+        return parallel ? halide_dgemv_trans_par(a, A, x, b, y, y) : halide_dgemv_trans(a, A, x, b, y, y);
     } else {
-        return halide_dgemv_notrans(a, A, x, b, y, y);
+        return parallel ? halide_dgemv_notrans_par(a, A, x, b, y, y) : halide_dgemv_notrans(a, A, x, b, y, y);
     }
 }
 
 inline int halide_sger(float a, halide_buffer_t *x, halide_buffer_t *y, halide_buffer_t *A) {
+    if (hblas_use_parallel_l2(A)) {
+        return halide_sger_impl_par(a, x, y, A);
+    }
     return halide_sger_impl(a, x, y, A);
 }
 
 inline int halide_dger(float a, halide_buffer_t *x, halide_buffer_t *y, halide_buffer_t *A) {
+    if (hblas_use_parallel_l2(A)) {
+        return halide_dger_impl_par(a, x, y, A);
+    }
     return halide_dger_impl(a, x, y, A);
 }
 
+inline int halide_ssymv(bool lower, float a, halide_buffer_t *A, halide_buffer_t *x, float b, halide_buffer_t *y) {
+    const bool parallel = hblas_use_parallel_l2(A);
+    if (lower) {
+        return parallel ? halide_ssymv_lower_par(a, A, x, b, y, y) : halide_ssymv_lower(a, A, x, b, y, y);
+    } else {
+        return parallel ? halide_ssymv_upper_par(a, A, x, b, y, y) : halide_ssymv_upper(a, A, x, b, y, y);
+    }
+}
+
+inline int halide_dsymv(bool lower, double a, halide_buffer_t *A, halide_buffer_t *x, double b, halide_buffer_t *y) {
+    const bool parallel = hblas_use_parallel_l2(A);
+    if (lower) {
+        return parallel ? halide_dsymv_lower_par(a, A, x, b, y, y) : halide_dsymv_lower(a, A, x, b, y, y);
+    } else {
+        return parallel ? halide_dsymv_upper_par(a, A, x, b, y, y) : halide_dsymv_upper(a, A, x, b, y, y);
+    }
+}
+
+inline int halide_ssyr(bool lower, float a, halide_buffer_t *x, halide_buffer_t *A) {
+    if (lower) {
+        return halide_ssyr_lower(a, x, A);
+    }
+    return halide_ssyr_upper(a, x, A);
+}
+
+inline int halide_dsyr(bool lower, double a, halide_buffer_t *x, halide_buffer_t *A) {
+    if (lower) {
+        return halide_dsyr_lower(a, x, A);
+    }
+    return halide_dsyr_upper(a, x, A);
+}
+
+inline int halide_ssyr2(bool lower, float a, halide_buffer_t *x, halide_buffer_t *y, halide_buffer_t *A) {
+    if (lower) {
+        return halide_ssyr2_lower(a, x, y, A);
+    }
+    return halide_ssyr2_upper(a, x, y, A);
+}
+
+inline int halide_dsyr2(bool lower, double a, halide_buffer_t *x, halide_buffer_t *y, halide_buffer_t *A) {
+    if (lower) {
+        return halide_dsyr2_lower(a, x, y, A);
+    }
+    return halide_dsyr2_upper(a, x, y, A);
+}
+
+inline int halide_strmv(bool lower, bool trans, bool unit, halide_buffer_t *A, halide_buffer_t *x) {
+    if (lower) {
+        return trans ? halide_strmv_lower_trans(unit, A, x, x) : halide_strmv_lower_notrans(unit, A, x, x);
+    } else {
+        return trans ? halide_strmv_upper_trans(unit, A, x, x) : halide_strmv_upper_notrans(unit, A, x, x);
+    }
+}
+
+inline int halide_dtrmv(bool lower, bool trans, bool unit, halide_buffer_t *A, halide_buffer_t *x) {
+    if (lower) {
+        return trans ? halide_dtrmv_lower_trans(unit, A, x, x) : halide_dtrmv_lower_notrans(unit, A, x, x);
+    } else {
+        return trans ? halide_dtrmv_upper_trans(unit, A, x, x) : halide_dtrmv_upper_notrans(unit, A, x, x);
+    }
+}
+
+inline int halide_strsv(bool lower, bool trans, bool unit, halide_buffer_t *A, halide_buffer_t *x) {
+    if (lower) {
+        return trans ? halide_strsv_lower_trans(unit, A, x, x) : halide_strsv_lower_notrans(unit, A, x, x);
+    } else {
+        return trans ? halide_strsv_upper_trans(unit, A, x, x) : halide_strsv_upper_notrans(unit, A, x, x);
+    }
+}
+
+inline int halide_dtrsv(bool lower, bool trans, bool unit, halide_buffer_t *A, halide_buffer_t *x) {
+    if (lower) {
+        return trans ? halide_dtrsv_lower_trans(unit, A, x, x) : halide_dtrsv_lower_notrans(unit, A, x, x);
+    } else {
+        return trans ? halide_dtrsv_upper_trans(unit, A, x, x) : halide_dtrsv_upper_notrans(unit, A, x, x);
+    }
+}
+
 inline int halide_sgemm(bool transA, bool transB, float a, halide_buffer_t *A, halide_buffer_t *B, float b, halide_buffer_t *C) {
     if (transA && transB) {
         return halide_sgemm_transAB(a, A, B, b, C, C);
@@ -103,6 +421,62 @@ inline int halide_dgemm(bool transA, bool transB, double a, halide_buffer_t *A,
     return -1;
 }
 
+inline int halide_sgemm_batched(bool transA, bool transB, float a, halide_buffer_t *A, halide_buffer_t *B, float b, halide_buffer_t *C) {
+    if (transA && transB) {
+        return halide_sgemm_batched_transAB(a, A, B, b, C, C);
+    } else if (transA) {
+        return halide_sgemm_batched_transA(a, A, B, b, C, C);
+    } else if (transB) {
+        return halide_sgemm_batched_transB(a, A, B, b, C, C);
+    } else {
+        return halide_sgemm_batched_notrans(a, A, B, b, C, C);
+    }
+}
+
+inline int halide_dgemm_batched(bool transA, bool transB, double a, halide_buffer_t *A, halide_buffer_t *B, double b, halide_buffer_t *C) {
+    if (transA && transB) {
+        return halide_dgemm_batched_transAB(a, A, B, b, C, C);
+    } else if (transA) {
+        return halide_dgemm_batched_transA(a, A, B, b, C, C);
+    } else if (transB) {
+        return halide_dgemm_batched_transB(a, A, B, b, C, C);
+    } else {
+        return halide_dgemm_batched_notrans(a, A, B, b, C, C);
+    }
+}
+
+inline int halide_strmm(bool lower, bool trans, bool unit, float a, halide_buffer_t *A, halide_buffer_t *B) {
+    if (lower) {
+        return trans ? halide_strmm_lower_trans(unit, a, A, B, B) : halide_strmm_lower_notrans(unit, a, A, B, B);
+    } else {
+        return trans ? halide_strmm_upper_trans(unit, a, A, B, B) : halide_strmm_upper_notrans(unit, a, A, B, B);
+    }
+}
+
+inline int halide_dtrmm(bool lower, bool trans, bool unit, double a, halide_buffer_t *A, halide_buffer_t *B) {
+    if (lower) {
+        return trans ? halide_dtrmm_lower_trans(unit, a, A, B, B) : halide_dtrmm_lower_notrans(unit, a, A, B, B);
+    } else {
+        return trans ? halide_dtrmm_upper_trans(unit, a, A, B, B) : halide_dtrmm_upper_notrans(unit, a, A, B, B);
+    }
+}
+
+inline int halide_strsm(bool lower, bool trans, bool unit, float a, halide_buffer_t *A, halide_buffer_t *B) {
+    if (lower) {
+        return trans ? halide_strsm_lower_trans(unit, a, A, B, B) : halide_strsm_lower_notrans(unit, a, A, B, B);
+    } else {
+        return trans ? halide_strsm_upper_trans(unit, a, A, B, B) : halide_strsm_upper_notrans(unit, a, A, B, B);
+    }
+}
+
+inline int halide_dtrsm(bool lower, bool trans, bool unit, double a, halide_buffer_t *A, halide_buffer_t *B) {
+    if (lower) {
+        return trans ? halide_dtrsm_lower_trans(unit, a, A, B, B) : halide_dtrsm_lower_notrans(unit, a, A, B, B);
+    } else {
+        return trans ? halide_dtrsm_upper_trans(unit, a, A, B, B) : halide_dtrsm_upper_notrans(unit, a, A, B, B);
+    }
+}
+
 enum HBLAS_ORDER { HblasRowMajor = 101,
                    HblasColMajor = 102 };
 enum HBLAS_TRANSPOSE { HblasNoTrans = 111,
@@ -115,6 +489,8 @@ enum HBLAS_DIAG { HblasNonUnit = 131,
 enum HBLAS_SIDE { HblasLeft = 141,
                   HblasRight = 142 };
 
+#define HBLAS_INDEX size_t
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -145,8 +521,8 @@ double hblas_dasum(const int N, const double *X, const int incX);
 /*
  * Functions having standard 4 prefixes (S D C Z)
  */
-// HBLAS_INDEX hblas_isamax(const int N, const float  *X, const int incX);
-// HBLAS_INDEX hblas_idamax(const int N, const double *X, const int incX);
+HBLAS_INDEX hblas_isamax(const int N, const float  *X, const int incX);
+HBLAS_INDEX hblas_idamax(const int N, const double *X, const int incX);
 // HBLAS_INDEX hblas_icamax(const int N, const void   *X, const int incX);
 // HBLAS_INDEX hblas_izamax(const int N, const void   *X, const int incX);
 
@@ -159,36 +535,40 @@ double hblas_dasum(const int N, const double *X, const int incX);
 /*
  * Routines with standard 4 prefixes (s, d, c, z)
  */
-// void hblas_sswap(const int N, float *X, const int incX,
-//                  float *Y, const int incY);
+void hblas_sswap(const int N, float *X, const int incX,
+                 float *Y, const int incY);
 void hblas_scopy(const int N, const float *X, const int incX,
                  float *Y, const int incY);
 void hblas_saxpy(const int N, const float alpha, const float *X,
                  const int incX, float *Y, const int incY);
+void hblas_saxpby(const int N, const float alpha, const float *X,
+                  const int incX, const float beta, float *Y, const int incY);
 
-// void hblas_dswap(const int N, double *X, const int incX,
-//                  double *Y, const int incY);
+void hblas_dswap(const int N, double *X, const int incX,
+                 double *Y, const int incY);
 void hblas_dcopy(const int N, const double *X, const int incX,
                  double *Y, const int incY);
 void hblas_daxpy(const int N, const double alpha, const double *X,
                  const int incX, double *Y, const int incY);
+void hblas_daxpby(const int N, const double alpha, const double *X,
+                  const int incX, const double beta, double *Y, const int incY);
 
 /*
  * Routines with S and D prefix only
  */
-// void hblas_srotg(float *a, float *b, float *c, float *s);
-// void hblas_srotmg(float *d1, float *d2, float *b1, const float b2, float *P);
-// void hblas_srot(const int N, float *X, const int incX,
-//                 float *Y, const int incY, const float c, const float s);
-// void hblas_srotm(const int N, float *X, const int incX,
-//                 float *Y, const int incY, const float *P);
-
-// void hblas_drotg(double *a, double *b, double *c, double *s);
-// void hblas_drotmg(double *d1, double *d2, double *b1, const double b2, double *P);
-// void hblas_drot(const int N, double *X, const int incX,
-//                 double *Y, const int incY, const double c, const double  s);
-// void hblas_drotm(const int N, double *X, const int incX,
-//                 double *Y, const int incY, const double *P);
+void hblas_srotg(float *a, float *b, float *c, float *s);
+void hblas_srotmg(float *d1, float *d2, float *b1, const float b2, float *P);
+void hblas_srot(const int N, float *X, const int incX,
+                float *Y, const int incY, const float c, const float s);
+void hblas_srotm(const int N, float *X, const int incX,
+                 float *Y, const int incY, const float *P);
+
+void hblas_drotg(double *a, double *b, double *c, double *s);
+void hblas_drotmg(double *d1, double *d2, double *b1, const double b2, double *P);
+void hblas_drot(const int N, double *X, const int incX,
+                double *Y, const int incY, const double c, const double s);
+void hblas_drotm(const int N, double *X, const int incX,
+                 double *Y, const int incY, const double *P);
 
 /*
  * Routines with S D C Z CS and ZD prefixes
@@ -225,6 +605,54 @@ void hblas_dger(const enum HBLAS_ORDER order, const int M, const int N,
                 const double alpha, const double *X, const int incX,
                 const double *Y, const int incY, double *A, const int lda);
 
+void hblas_ssymv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const float alpha, const float *A,
+                 const int lda, const float *X, const int incX,
+                 const float beta, float *Y, const int incY);
+
+void hblas_dsymv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const double alpha, const double *A,
+                 const int lda, const double *X, const int incX,
+                 const double beta, double *Y, const int incY);
+
+void hblas_ssyr(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                const int N, const float alpha, const float *X,
+                const int incX, float *A, const int lda);
+
+void hblas_dsyr(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                const int N, const double alpha, const double *X,
+                const int incX, double *A, const int lda);
+
+void hblas_ssyr2(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const float alpha, const float *X,
+                 const int incX, const float *Y, const int incY,
+                 float *A, const int lda);
+
+void hblas_dsyr2(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const int N, const double alpha, const double *X,
+                 const int incX, const double *Y, const int incY,
+                 double *A, const int lda);
+
+void hblas_strmv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE TransA, const enum HBLAS_DIAG Diag,
+                 const int N, const float *A, const int lda,
+                 float *X, const int incX);
+
+void hblas_dtrmv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE TransA, const enum HBLAS_DIAG Diag,
+                 const int N, const double *A, const int lda,
+                 double *X, const int incX);
+
+void hblas_strsv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE TransA, const enum HBLAS_DIAG Diag,
+                 const int N, const float *A, const int lda,
+                 float *X, const int incX);
+
+void hblas_dtrsv(const enum HBLAS_ORDER order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE TransA, const enum HBLAS_DIAG Diag,
+                 const int N, const double *A, const int lda,
+                 double *X, const int incX);
+
 /*
  * ===========================================================================
  * Prototypes for level 3 BLAS
@@ -246,6 +674,80 @@ void hblas_dgemm(const enum HBLAS_ORDER Order, const enum HBLAS_TRANSPOSE TransA
                  const int lda, const double *B, const int ldb,
                  const double beta, double *C, const int ldc);
 
+void hblas_sgemm_strided_batched(const enum HBLAS_ORDER Order, const enum HBLAS_TRANSPOSE TransA,
+                                 const enum HBLAS_TRANSPOSE TransB, const int M, const int N,
+                                 const int K, const float alpha, const float *A,
+                                 const int lda, const int strideA, const float *B,
+                                 const int ldb, const int strideB, const float beta,
+                                 float *C, const int ldc, const int strideC,
+                                 const int batch_count);
+
+void hblas_dgemm_strided_batched(const enum HBLAS_ORDER Order, const enum HBLAS_TRANSPOSE TransA,
+                                 const enum HBLAS_TRANSPOSE TransB, const int M, const int N,
+                                 const int K, const double alpha, const double *A,
+                                 const int lda, const int strideA, const double *B,
+                                 const int ldb, const int strideB, const double beta,
+                                 double *C, const int ldc, const int strideC,
+                                 const int batch_count);
+
+void hblas_ssyrk(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                 const float alpha, const float *A, const int lda,
+                 const float beta, float *C, const int ldc);
+
+void hblas_dsyrk(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                 const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                 const double alpha, const double *A, const int lda,
+                 const double beta, double *C, const int ldc);
+
+void hblas_ssyr2k(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                  const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                  const float alpha, const float *A, const int lda,
+                  const float *B, const int ldb, const float beta,
+                  float *C, const int ldc);
+
+void hblas_dsyr2k(const enum HBLAS_ORDER Order, const enum HBLAS_UPLO Uplo,
+                  const enum HBLAS_TRANSPOSE Trans, const int N, const int K,
+                  const double alpha, const double *A, const int lda,
+                  const double *B, const int ldb, const double beta,
+                  double *C, const int ldc);
+
+void hblas_ssymm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const int M, const int N,
+                 const float alpha, const float *A, const int lda,
+                 const float *B, const int ldb, const float beta,
+                 float *C, const int ldc);
+
+void hblas_dsymm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const int M, const int N,
+                 const double alpha, const double *A, const int lda,
+                 const double *B, const int ldb, const double beta,
+                 double *C, const int ldc);
+
+void hblas_strmm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const float alpha, const float *A, const int lda,
+                 float *B, const int ldb);
+
+void hblas_dtrmm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const double alpha, const double *A, const int lda,
+                 double *B, const int ldb);
+
+void hblas_strsm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const float alpha, const float *A, const int lda,
+                 float *B, const int ldb);
+
+void hblas_dtrsm(const enum HBLAS_ORDER Order, const enum HBLAS_SIDE Side,
+                 const enum HBLAS_UPLO Uplo, const enum HBLAS_TRANSPOSE TransA,
+                 const enum HBLAS_DIAG Diag, const int M, const int N,
+                 const double alpha, const double *A, const int lda,
+                 double *B, const int ldb);
+
 #ifdef __cplusplus
 }
 #endif
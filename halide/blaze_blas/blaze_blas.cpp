@@ -6,6 +6,7 @@
 #include <hpx/config.hpp>
 
 #include "blaze_blas.hpp"
+#include "launch_policy.hpp"
 
 #include <phylanx/config.hpp>
 
@@ -232,84 +233,48 @@ namespace phylanx_blaze_blas_plugin {
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
+        using phylanx_halide_common::launch_kernel;
+        using phylanx_halide_common::operand_values;
+
+        // operations on small operands run inline, all others on a new HPX
+        // thread
+        static phylanx_halide_common::launch_policy const policy(
+            "blaze_blas", 65536);
+
         auto this_ = this->shared_from_this();
-        auto ctx_ = ctx;
 
         if (2 == operands.size() && this_->mode_ == DSCAL)
         {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& x)
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
                 ->primitive_argument_type {
-                return this_->blaze_dscal(a.get(), x.get());
+                return this_->blaze_dscal(std::move(a[0]), std::move(a[1]));
             },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx));
+                operand_values(operands, args, name_, codename_, ctx));
         }
 
         if (6 == operands.size() && this_->mode_ == DGEMV)
         {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& is_trans,
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& A,
-                    hpx::future<primitive_argument_type>&& x,
-                    hpx::future<primitive_argument_type>&& b,
-                    hpx::future<primitive_argument_type>&& y)
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
                 ->primitive_argument_type {
-                return this_->blaze_dgemv(is_trans.get(), a.get(), A.get(),
-                    x.get(), b.get(), y.get());
+                return this_->blaze_dgemv(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]));
             },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[3], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[4], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[5], args, name_, codename_, ctx));
+                operand_values(operands, args, name_, codename_, ctx));
         }
 
         if (7 == operands.size() && this_->mode_ == DGEMM)
         {
-            return hpx::dataflow(
-                hpx::launch::sync,
-                [this_ = std::move(this_), ctx = std::move(ctx_)](
-                    hpx::future<primitive_argument_type>&& is_a_trans,
-                    hpx::future<primitive_argument_type>&& is_b_trans,
-                    hpx::future<primitive_argument_type>&& a,
-                    hpx::future<primitive_argument_type>&& A,
-                    hpx::future<primitive_argument_type>&& B,
-                    hpx::future<primitive_argument_type>&& b,
-                    hpx::future<primitive_argument_type>&& C)
+            return launch_kernel(policy,
+                [this_ = std::move(this_)](primitive_arguments_type&& a)
                 ->primitive_argument_type {
-                return this_->blaze_dgemm(is_a_trans.get(), is_b_trans.get(), a.get(), A.get(),
-                    B.get(), b.get(), C.get());
+                return this_->blaze_dgemm(std::move(a[0]), std::move(a[1]),
+                    std::move(a[2]), std::move(a[3]), std::move(a[4]),
+                    std::move(a[5]), std::move(a[6]));
             },
-                phylanx::execution_tree::value_operand(
-                    operands[0], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[1], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[2], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[3], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[4], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[5], args, name_, codename_, ctx),
-                phylanx::execution_tree::value_operand(
-                    operands[6], args, name_, codename_, ctx));
+                operand_values(operands, args, name_, codename_, ctx));
         }
         HPX_THROW_EXCEPTION(hpx::bad_parameter,
             "Non BLAS function",
@@ -0,0 +1,273 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "arena.hpp"
+#include "pipeline.hpp"
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/iostream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        // the header in front of every block, Halide expects its buffers to
+        // be aligned to 128 bytes
+        struct alignas(128) block_header
+        {
+            std::uint32_t size_class;    // index of the size class
+            std::uint32_t owner;         // worker owning the block
+        };
+
+        // owner of the blocks allocated directly from the system
+        constexpr std::uint32_t no_owner = std::uint32_t(-1);
+
+        constexpr std::size_t page_size = 4096;
+
+        std::size_t size_class_of(std::size_t size, std::size_t min_bits)
+        {
+            std::size_t bits = min_bits;
+            while ((std::size_t(1) << bits) < size)
+            {
+                ++bits;
+            }
+            return bits - min_bits;
+        }
+
+        std::size_t max_cached_bytes()
+        {
+            std::string const value =
+                hpx::get_config_entry("phylanx.halide.arena.max_bytes", "");
+            return parse_size(value, std::size_t(64) << 20);
+        }
+
+        void print_report()
+        {
+            for (pipeline_state* p : pipelines())
+            {
+                allocation_statistics const stats =
+                    p->get_allocation_statistics();
+                if (stats.allocations == 0)
+                {
+                    continue;
+                }
+                hpx::cout << "halide_malloc("
+                          << (p->name().empty() ? "<none>" : p->name())
+                          << "): " << stats.allocations << " allocations, "
+                          << stats.bytes << " bytes, "
+                          << stats.system_allocations
+                          << " from the system\n";
+            }
+            hpx::cout << hpx::flush;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    arena& arena::instance()
+    {
+        static arena a;
+        return a;
+    }
+
+    arena::arena()
+      : max_cached_(max_cached_bytes())
+    {
+        std::size_t const num_workers = hpx::get_os_thread_count();
+
+        workers_.reserve(num_workers);
+        for (std::size_t i = 0; i != num_workers; ++i)
+        {
+            workers_.push_back(std::make_unique<worker_cache>());
+        }
+
+        if (hpx::get_config_entry("phylanx.halide.arena.report", "0") == "1")
+        {
+            hpx::register_shutdown_function(&print_report);
+        }
+    }
+
+    arena::~arena()
+    {
+        for (auto& cache : workers_)
+        {
+            for (auto& list : cache->blocks)
+            {
+                for (void* block : list)
+                {
+                    std::free(block);
+                }
+            }
+            for (void* block : cache->returned)
+            {
+                std::free(block);
+            }
+        }
+    }
+
+    void* arena::allocate_system(std::size_t size)
+    {
+        // aligned_alloc requires a multiple of the alignment
+        std::size_t const bytes = sizeof(block_header) +
+            (size + alignof(block_header) - 1) / alignof(block_header) *
+                alignof(block_header);
+
+        void* block = std::aligned_alloc(alignof(block_header), bytes);
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+        new (block) block_header{0, no_owner};
+        return block;
+    }
+
+    void* arena::allocate_block(std::size_t size_class, std::size_t owner)
+    {
+        std::size_t const bytes =
+            std::size_t(1) << (size_class + min_class_bits);
+
+        void* block = std::aligned_alloc(
+            alignof(block_header), sizeof(block_header) + bytes);
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+
+        // touch all pages from the owning worker (first touch places them
+        // on its NUMA domain)
+        char* data = static_cast<char*>(block) + sizeof(block_header);
+        for (std::size_t offset = 0; offset < bytes; offset += page_size)
+        {
+            data[offset] = 0;
+        }
+
+        new (block)
+            block_header{std::uint32_t(size_class), std::uint32_t(owner)};
+        return block;
+    }
+
+    // called by the owner of the cache only
+    void arena::cache_block(worker_cache& cache, void* block)
+    {
+        auto const* header = static_cast<block_header const*>(block);
+        std::size_t const bytes =
+            std::size_t(1) << (header->size_class + min_class_bits);
+
+        // blocks exceeding the limit are given back to the system
+        if (cache.cached + bytes > max_cached_)
+        {
+            std::free(block);
+            return;
+        }
+
+        cache.cached += bytes;
+        cache.blocks[header->size_class].push_back(block);
+    }
+
+    // move the blocks released by other threads to the free lists
+    void arena::reclaim(worker_cache& cache)
+    {
+        std::vector<void*> returned;
+        {
+            std::lock_guard<std::mutex> l(cache.mtx);
+            std::swap(returned, cache.returned);
+        }
+
+        for (void* block : returned)
+        {
+            cache_block(cache, block);
+        }
+    }
+
+    void* arena::allocate(std::size_t size)
+    {
+        std::size_t const size_class = size_class_of(size, min_class_bits);
+        std::size_t const worker = hpx::get_worker_thread_num();
+
+        void* block = nullptr;
+        bool system = true;
+        if (size_class >= num_classes || worker >= workers_.size())
+        {
+            block = allocate_system(size);
+        }
+        else
+        {
+            worker_cache& cache = *workers_[worker];
+            auto& list = cache.blocks[size_class];
+            if (list.empty())
+            {
+                reclaim(cache);
+            }
+
+            if (!list.empty())
+            {
+                block = list.back();
+                list.pop_back();
+                cache.cached -=
+                    std::size_t(1) << (size_class + min_class_bits);
+                system = false;
+            }
+            else
+            {
+                block = allocate_block(size_class, worker);
+            }
+        }
+
+        current_pipeline().count_allocation(size, system);
+
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+        return static_cast<char*>(block) + sizeof(block_header);
+    }
+
+    void arena::deallocate(void* p)
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+
+        void* block = static_cast<char*>(p) - sizeof(block_header);
+        auto const* header = static_cast<block_header const*>(block);
+        if (header->owner == no_owner)
+        {
+            std::free(block);
+            return;
+        }
+
+        worker_cache& cache = *workers_[header->owner];
+        if (hpx::get_worker_thread_num() == header->owner)
+        {
+            cache_block(cache, block);
+            return;
+        }
+
+        std::lock_guard<std::mutex> l(cache.mtx);
+        cache.returned.push_back(block);
+    }
+
+    void* arena::malloc_hook(void*, std::size_t size)
+    {
+        return instance().allocate(size);
+    }
+
+    void arena::free_hook(void*, void* p)
+    {
+        instance().deallocate(p);
+    }
+}
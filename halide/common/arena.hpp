@@ -0,0 +1,73 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    // The allocator behind halide_malloc and halide_free, which the
+    // pipelines use for their intermediate buffers. Every HPX worker thread
+    // owns a cache of blocks grouped into power of two size classes and
+    // serves its requests from there without locking. Blocks released by
+    // another thread are handed back to their owner through a return list.
+    // New blocks are pre-faulted by the owning worker, which places their
+    // pages on its NUMA domain; reusing them from the same worker keeps the
+    // intermediates of a pipeline close to the cores computing them.
+    //
+    // Requests beyond the largest size class and requests made outside of
+    // HPX worker threads go directly to the system. The cache of a worker is
+    // limited by 'phylanx.halide.arena.max_bytes' (default: 64 MiB).
+    //
+    // The number of allocations and the bytes requested are counted for the
+    // current pipeline (see pipeline.hpp). With 'phylanx.halide.arena.report'
+    // set to 1 they are printed when HPX shuts down.
+    class arena
+    {
+    public:
+        static arena& instance();
+
+        void* allocate(std::size_t size);
+        void deallocate(void* p);
+
+        // the hooks to be passed to halide_set_custom_malloc/free
+        static void* malloc_hook(void* ctx, std::size_t size);
+        static void free_hook(void* ctx, void* p);
+
+    private:
+        arena();
+        ~arena();
+
+        static constexpr std::size_t min_class_bits = 8;     // 256 B
+        static constexpr std::size_t max_class_bits = 30;    // 1 GiB
+        static constexpr std::size_t num_classes =
+            max_class_bits - min_class_bits + 1;
+
+        struct alignas(64) worker_cache
+        {
+            // only accessed by the owning worker
+            std::array<std::vector<void*>, num_classes> blocks;
+            std::size_t cached = 0;
+
+            // blocks released by other threads
+            std::mutex mtx;
+            std::vector<void*> returned;
+        };
+
+        void* allocate_system(std::size_t size);
+        void* allocate_block(std::size_t size_class, std::size_t owner);
+        void cache_block(worker_cache& cache, void* block);
+        void reclaim(worker_cache& cache);
+
+        std::vector<std::unique_ptr<worker_cache>> workers_;
+        std::size_t const max_cached_;
+    };
+}
@@ -0,0 +1,206 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "buffer_pool.hpp"
+#include "pipeline.hpp"
+
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        // the header in front of every block, it keeps the block aligned to
+        // a cache line
+        struct alignas(64) block_header
+        {
+            std::uint32_t size_class;    // index of the size class
+            std::uint32_t domain;        // NUMA domain of the free list
+        };
+
+        constexpr std::size_t page_size = 4096;
+
+        std::size_t size_class_of(std::size_t size, std::size_t min_bits)
+        {
+            std::size_t bits = min_bits;
+            while ((std::size_t(1) << bits) < size)
+            {
+                ++bits;
+            }
+            return bits - min_bits;
+        }
+
+        std::size_t max_cached_bytes()
+        {
+            std::string const value = hpx::get_config_entry(
+                "phylanx.halide.buffer_pool.max_bytes", "");
+            return parse_size(value, std::size_t(1) << 30);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    buffer_pool& buffer_pool::instance()
+    {
+        static buffer_pool pool;
+        return pool;
+    }
+
+    buffer_pool::buffer_pool()
+      : max_cached_(max_cached_bytes())
+      , hits_(0)
+      , misses_(0)
+      , cached_(0)
+    {
+        std::size_t const num_domains = (std::max)(std::size_t(1),
+            hpx::threads::create_topology().get_number_of_numa_nodes());
+
+        domains_.reserve(num_domains);
+        for (std::size_t i = 0; i != num_domains; ++i)
+        {
+            domains_.push_back(std::make_unique<domain_lists>());
+        }
+    }
+
+    buffer_pool::~buffer_pool()
+    {
+        for (auto& lists : domains_)
+        {
+            for (auto& list : *lists)
+            {
+                for (void* block : list.blocks)
+                {
+                    std::free(block);
+                }
+            }
+        }
+    }
+
+    std::size_t buffer_pool::current_domain() const
+    {
+        std::size_t const thread = hpx::get_worker_thread_num();
+        if (thread == std::size_t(-1))
+        {
+            return 0;
+        }
+
+        // the topology is indexed by processing unit, the worker threads may
+        // be bound to any of them (e.g. --hpx:bind or a thread pool of its
+        // own)
+        std::size_t const pu =
+            hpx::resource::get_partitioner().get_pu_num(thread);
+        std::size_t const domain =
+            hpx::threads::create_topology().get_numa_node_number(pu);
+        return domain < domains_.size() ? domain : 0;
+    }
+
+    void* buffer_pool::allocate(std::size_t size)
+    {
+        std::size_t const size_class = size_class_of(size, min_class_bits);
+        if (size_class >= num_classes)
+        {
+            throw std::bad_alloc();
+        }
+
+        std::size_t const domain = current_domain();
+        free_list& list = (*domains_[domain])[size_class];
+        std::size_t const bytes =
+            std::size_t(1) << (size_class + min_class_bits);
+
+        void* block = nullptr;
+        {
+            std::lock_guard<std::mutex> l(list.mtx);
+            if (!list.blocks.empty())
+            {
+                block = list.blocks.back();
+                list.blocks.pop_back();
+            }
+        }
+
+        if (block != nullptr)
+        {
+            ++hits_;
+            cached_ -= bytes;
+        }
+        else
+        {
+            ++misses_;
+
+            block = std::aligned_alloc(
+                alignof(block_header), sizeof(block_header) + bytes);
+            if (block == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            // touch all pages from this thread (first touch places them on
+            // its NUMA domain), the first use of the block won't fault
+            char* data = static_cast<char*>(block) + sizeof(block_header);
+            for (std::size_t offset = 0; offset < bytes; offset += page_size)
+            {
+                data[offset] = 0;
+            }
+
+            new (block) block_header{
+                std::uint32_t(size_class), std::uint32_t(domain)};
+        }
+
+        return static_cast<char*>(block) + sizeof(block_header);
+    }
+
+    void buffer_pool::deallocate(void* p)
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+
+        void* block = static_cast<char*>(p) - sizeof(block_header);
+        auto const* header = static_cast<block_header const*>(block);
+        std::size_t const bytes =
+            std::size_t(1) << (header->size_class + min_class_bits);
+
+        // blocks exceeding the limit are given back to the system, the
+        // bytes are reserved first such that concurrent releases can't
+        // overshoot the limit together
+        if (cached_.fetch_add(bytes) + bytes > max_cached_)
+        {
+            cached_ -= bytes;
+            std::free(block);
+            return;
+        }
+
+        free_list& list = (*domains_[header->domain])[header->size_class];
+        std::lock_guard<std::mutex> l(list.mtx);
+        list.blocks.push_back(block);
+    }
+
+    pool_statistics buffer_pool::get_statistics() const
+    {
+        return pool_statistics{hits_, misses_, cached_};
+    }
+
+    void* buffer_pool::halide_allocate(std::size_t size)
+    {
+        return instance().allocate(size);
+    }
+
+    void buffer_pool::halide_deallocate(void* p)
+    {
+        instance().deallocate(p);
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    // the statistics of the pools, see install_pool_counters (counters.hpp)
+    struct pool_statistics
+    {
+        std::uint64_t hits;      // requests served from the pool
+        std::uint64_t misses;    // requests requiring a new allocation
+        std::uint64_t cached;    // bytes held by the pool
+    };
+
+    // A pool of intermediate (scratch) buffers shared by all plugins. The
+    // results handed to Phylanx are blaze arrays, they are recycled by the
+    // result pool (see result_pool.hpp). Blocks are grouped into power of
+    // two size classes, a released block is kept on the free list of its
+    // size class and NUMA domain and is handed out again to the next request
+    // of that class on the same domain. New blocks are pre-faulted by the requesting
+    // thread, which places their pages on the domain of that thread.
+    //
+    // The cached memory is limited by 'phylanx.halide.buffer_pool.max_bytes'
+    // (default: 1 GiB), blocks beyond that are returned to the system. The
+    // hits, misses and cached bytes are reported by the HPX performance
+    // counters /halide/buffer_pool/* (see install_buffer_pool_counters).
+    class buffer_pool
+    {
+    public:
+        static buffer_pool& instance();
+
+        void* allocate(std::size_t size);
+        void deallocate(void* p);
+
+        pool_statistics get_statistics() const;
+
+        // allocation functions to be passed to Halide::Runtime::Buffer
+        static void* halide_allocate(std::size_t size);
+        static void halide_deallocate(void* p);
+
+    private:
+        buffer_pool();
+        ~buffer_pool();
+
+        static constexpr std::size_t min_class_bits = 12;    // 4 KiB
+        static constexpr std::size_t max_class_bits = 31;    // 2 GiB
+        static constexpr std::size_t num_classes =
+            max_class_bits - min_class_bits + 1;
+
+        struct free_list
+        {
+            std::mutex mtx;
+            std::vector<void*> blocks;
+        };
+
+        using domain_lists = std::array<free_list, num_classes>;
+
+        std::size_t current_domain() const;
+
+        std::vector<std::unique_ptr<domain_lists>> domains_;
+        std::size_t const max_cached_;
+
+        std::atomic<std::uint64_t> hits_;
+        std::atomic<std::uint64_t> misses_;
+        std::atomic<std::uint64_t> cached_;
+    };
+}
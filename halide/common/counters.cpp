@@ -0,0 +1,202 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "buffer_pool.hpp"
+#include "counters.hpp"
+#include "pipeline.hpp"
+
+#include <hpx/include/performance_counters.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        kernel_statistics difference(
+            kernel_statistics const& lhs, kernel_statistics const& rhs)
+        {
+            return kernel_statistics{lhs.calls - rhs.calls,
+                lhs.time - rhs.time, lhs.flops - rhs.flops,
+                lhs.bytes - rhs.bytes, lhs.par_for_tasks - rhs.par_for_tasks};
+        }
+
+        // A counter reporting a value derived from the statistics of a
+        // kernel accumulated since the counter was last reset.
+        template <typename F>
+        hpx::util::function_nonser<std::int64_t(bool)> make_counter(
+            pipeline_state& state, F value)
+        {
+            struct baseline_type
+            {
+                std::mutex mtx;
+                kernel_statistics stats{};
+            };
+            auto baseline = std::make_shared<baseline_type>();
+
+            return [&state, baseline, value](bool reset) -> std::int64_t {
+                kernel_statistics const current = state.get_kernel_statistics();
+
+                std::lock_guard<std::mutex> l(baseline->mtx);
+                std::int64_t const result =
+                    value(difference(current, baseline->stats));
+                if (reset)
+                {
+                    baseline->stats = current;
+                }
+                return result;
+            };
+        }
+
+        // A counter reporting a value derived from the statistics of a pool,
+        // the hits and misses are counted since the counter was last reset.
+        template <typename F>
+        hpx::util::function_nonser<std::int64_t(bool)> make_pool_counter(
+            std::function<pool_statistics()> const& statistics, F value)
+        {
+            struct baseline_type
+            {
+                std::mutex mtx;
+                pool_statistics stats{};
+            };
+            auto baseline = std::make_shared<baseline_type>();
+
+            return [statistics, baseline, value](bool reset) -> std::int64_t {
+                pool_statistics const current = statistics();
+
+                std::lock_guard<std::mutex> l(baseline->mtx);
+                std::int64_t const result =
+                    value(pool_statistics{current.hits - baseline->stats.hits,
+                        current.misses - baseline->stats.misses,
+                        current.cached});
+                if (reset)
+                {
+                    baseline->stats = current;
+                }
+                return result;
+            };
+        }
+
+        // rate in millions per second for the given amount and time [ns]
+        std::int64_t mega_per_second(std::uint64_t amount, std::uint64_t time)
+        {
+            if (time == 0)
+            {
+                return 0;
+            }
+            return std::int64_t(1e3 * double(amount) / double(time));
+        }
+    }
+
+    void install_kernel_counters(std::string const& kernel)
+    {
+        static std::mutex mtx;
+        static std::set<std::string> installed;
+
+        std::lock_guard<std::mutex> l(mtx);
+        if (!installed.insert(kernel).second)
+        {
+            return;
+        }
+
+        using hpx::performance_counters::install_counter_type;
+
+        pipeline_state& state = get_pipeline(kernel);
+        std::string const prefix = "/halide/" + kernel;
+
+        install_counter_type(prefix + "/calls",
+            make_counter(state,
+                [](kernel_statistics const& s) {
+                    return std::int64_t(s.calls);
+                }),
+            "returns the number of calls of the kernel " + kernel);
+
+        install_counter_type(prefix + "/time",
+            make_counter(state,
+                [](kernel_statistics const& s) {
+                    return std::int64_t(s.time);
+                }),
+            "returns the wall time spent in the kernel " + kernel, "ns");
+
+        install_counter_type(prefix + "/mflops",
+            make_counter(state,
+                [](kernel_statistics const& s) {
+                    return mega_per_second(s.flops, s.time);
+                }),
+            "returns the floating point rate achieved by the kernel " +
+                kernel,
+            "MFLOP/s");
+
+        install_counter_type(prefix + "/bandwidth",
+            make_counter(state,
+                [](kernel_statistics const& s) {
+                    return mega_per_second(s.bytes, s.time);
+                }),
+            "returns the memory bandwidth achieved by the kernel " + kernel,
+            "MB/s");
+
+        install_counter_type(prefix + "/par_for_tasks",
+            make_counter(state,
+                [](kernel_statistics const& s) {
+                    return std::int64_t(s.par_for_tasks);
+                }),
+            "returns the number of parallel loop iterations run by the "
+            "kernel " +
+                kernel);
+    }
+
+    void install_pool_counters(std::string const& pool,
+        std::function<pool_statistics()> statistics)
+    {
+        static std::mutex mtx;
+        static std::set<std::string> installed;
+
+        std::lock_guard<std::mutex> l(mtx);
+        if (!installed.insert(pool).second)
+        {
+            return;
+        }
+
+        using hpx::performance_counters::install_counter_type;
+
+        std::string const prefix = "/halide/" + pool;
+
+        install_counter_type(prefix + "/hits",
+            make_pool_counter(statistics,
+                [](pool_statistics const& s) {
+                    return std::int64_t(s.hits);
+                }),
+            "returns the number of requests served from the " + pool);
+
+        install_counter_type(prefix + "/misses",
+            make_pool_counter(statistics,
+                [](pool_statistics const& s) {
+                    return std::int64_t(s.misses);
+                }),
+            "returns the number of requests the " + pool +
+                " could not serve from its cache");
+
+        install_counter_type(prefix + "/cached",
+            make_pool_counter(statistics,
+                [](pool_statistics const& s) {
+                    return std::int64_t(s.cached);
+                }),
+            "returns the memory currently held by the " + pool, "bytes");
+    }
+
+    void install_buffer_pool_counters()
+    {
+        install_pool_counters("buffer_pool",
+            [] { return buffer_pool::instance().get_statistics(); });
+    }
+}
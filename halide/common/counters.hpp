@@ -0,0 +1,74 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "buffer_pool.hpp"
+#include "pipeline.hpp"
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace phylanx_halide_common {
+
+    // Install the HPX performance counters of a kernel (once per kernel):
+    //
+    //   /halide{locality#*/total}/<kernel>/calls          number of calls
+    //   /halide{locality#*/total}/<kernel>/time           wall time [ns]
+    //   /halide{locality#*/total}/<kernel>/mflops         achieved MFLOP/s
+    //   /halide{locality#*/total}/<kernel>/bandwidth      achieved MB/s
+    //   /halide{locality#*/total}/<kernel>/par_for_tasks  loop iterations
+    //
+    // All values cover the calls since the counter was last reset. The rates
+    // are reported in MFLOP/s and MB/s as the counters are integers.
+    void install_kernel_counters(std::string const& kernel);
+
+    // Install the HPX performance counters of a pool (once per pool):
+    //
+    //   /halide{locality#*/total}/<pool>/hits    requests served from the pool
+    //   /halide{locality#*/total}/<pool>/misses  requests allocating anew
+    //   /halide{locality#*/total}/<pool>/cached  bytes held by the pool
+    //
+    // The hits and misses cover the requests since the counter was last
+    // reset, the cached bytes are the current value.
+    void install_pool_counters(std::string const& pool,
+        std::function<pool_statistics()> statistics);
+
+    // install_pool_counters for the buffer pool (see buffer_pool.hpp)
+    void install_buffer_pool_counters();
+
+    // Account one call of a kernel: the wall time between construction and
+    // destruction as well as the estimated FLOPs and bytes moved.
+    class kernel_timer
+    {
+    public:
+        kernel_timer(char const* kernel, double flops, double bytes)
+          : state_(get_pipeline(kernel))
+          , flops_(flops)
+          , bytes_(bytes)
+          , start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~kernel_timer()
+        {
+            auto const elapsed = std::chrono::steady_clock::now() - start_;
+            state_.count_call(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                    .count(),
+                flops_, bytes_);
+        }
+
+        kernel_timer(kernel_timer const&) = delete;
+        kernel_timer& operator=(kernel_timer const&) = delete;
+
+    private:
+        pipeline_state& state_;
+        double flops_;
+        double bytes_;
+        std::chrono::steady_clock::time_point start_;
+    };
+}
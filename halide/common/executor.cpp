@@ -0,0 +1,107 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "executor.hpp"
+
+#include <hpx/include/runtime.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        hpx::threads::thread_pool_base* find_kernel_pool()
+        {
+            std::string const name =
+                hpx::get_config_entry("phylanx.halide.thread_pool", "halide");
+            if (hpx::resource::pool_exists(name))
+            {
+                return &hpx::resource::get_thread_pool(name);
+            }
+            return &hpx::resource::get_thread_pool(0);
+        }
+
+        hpx::threads::thread_priority parse_priority(std::string const& value)
+        {
+            if (value == "high")
+            {
+                return hpx::threads::thread_priority::high;
+            }
+            if (value == "low")
+            {
+                return hpx::threads::thread_priority::low;
+            }
+            return hpx::threads::thread_priority::normal;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::threads::thread_pool_base* kernel_pool()
+    {
+        static hpx::threads::thread_pool_base* const pool = find_kernel_pool();
+        return pool;
+    }
+
+    hpx::execution::parallel_executor kernel_executor(
+        hpx::threads::thread_priority priority)
+    {
+        return hpx::execution::parallel_executor(kernel_pool(), priority);
+    }
+
+    hpx::threads::thread_priority kernel_priority(std::string const& primitive)
+    {
+        std::string value;
+        if (!primitive.empty())
+        {
+            value = hpx::get_config_entry(
+                "phylanx.halide." + primitive + ".priority", "");
+        }
+        if (value.empty())
+        {
+            value = hpx::get_config_entry("phylanx.halide.priority", "normal");
+        }
+        return parse_priority(value);
+    }
+
+    void create_kernel_pool(hpx::resource::partitioner& rp,
+        std::size_t num_cores, std::string const& name)
+    {
+        std::vector<hpx::resource::core const*> cores;
+        for (auto const& domain : rp.numa_domains())
+        {
+            for (auto const& core : domain.cores())
+            {
+                cores.push_back(&core);
+            }
+        }
+
+        if (cores.size() < 2)
+        {
+            return;
+        }
+        if (num_cores >= cores.size())
+        {
+            num_cores = cores.size() - 1;
+        }
+        if (num_cores == 0)
+        {
+            return;
+        }
+
+        rp.create_thread_pool(name);
+        for (std::size_t i = cores.size() - num_cores; i != cores.size(); ++i)
+        {
+            for (auto const& pu : cores[i]->pus())
+            {
+                rp.add_resource(pu, name);
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace phylanx_halide_common {
+
+    // The HPX threads of the Halide kernels (the kernel launches as well as
+    // the parallel loops and tasks of the pipelines) run on the pool named
+    // by 'phylanx.halide.thread_pool' (default: "halide") if the application
+    // created it, and on the default pool otherwise.
+    hpx::threads::thread_pool_base* kernel_pool();
+
+    // An executor scheduling HPX threads with the given priority on the
+    // kernel pool.
+    hpx::execution::parallel_executor kernel_executor(
+        hpx::threads::thread_priority priority);
+
+    // The priority of the HPX threads of a primitive (or pipeline):
+    //
+    //   phylanx.halide.<primitive>.priority = low | normal | high
+    //   phylanx.halide.priority             = low | normal | high
+    //
+    // the latter applying to all primitives without a setting of their own
+    // (default: normal).
+    hpx::threads::thread_priority kernel_priority(std::string const& primitive);
+
+    // Create the kernel pool from the resource partitioner callback of the
+    // application (the pools are fixed once the HPX runtime is running). The
+    // pool is given the last num_cores cores of the machine, at least one
+    // core is left to the default pool.
+    void create_kernel_pool(hpx::resource::partitioner& rp,
+        std::size_t num_cores, std::string const& name = "halide");
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include <HalideRuntime.h>
+
+#include "arena.hpp"
+#include "par_for.hpp"
+#include "parallel_tasks.hpp"
+#include "trace.hpp"
+
+#include <cstdint>
+#include <mutex>
+
+// the chunking of the loop is selected by the pipeline being run
+extern "C" int hpx_halide_do_par_for(void* ctx, int (*f)(void*, int, uint8_t*),
+    int min, int extent, uint8_t * closure) {
+    return phylanx_halide_common::do_par_for(ctx, f, min, extent, closure);
+}
+
+namespace {
+
+    void register_halide_runtime()
+    {
+        // register halide custom handlers, parallel loops as well as async
+        // producers and their semaphores run on HPX threads
+        ::halide_set_custom_parallel_runtime(&hpx_halide_do_par_for,
+            &phylanx_halide_common::do_task,
+            &phylanx_halide_common::do_loop_task,
+            &phylanx_halide_common::do_parallel_tasks,
+            &phylanx_halide_common::semaphore_init,
+            &phylanx_halide_common::semaphore_try_acquire,
+            &phylanx_halide_common::semaphore_release);
+
+        // intermediate buffers are served from per-worker arenas
+        ::halide_set_custom_malloc(&phylanx_halide_common::arena::malloc_hook);
+        ::halide_set_custom_free(&phylanx_halide_common::arena::free_hook);
+
+#if defined(PHYLANX_HALIDE_HAVE_TRACING)
+        // the trace events of the pipelines go to the Chrome trace
+        ::halide_set_custom_trace(
+            &phylanx_halide_common::trace_recorder::trace_hook);
+#endif
+    }
+}
+
+// Make sure to register the HPX backend functionalities. All plugins link
+// this library, the hooks are installed once per process.
+struct on_load
+{
+    on_load()
+    {
+        static std::once_flag registered;
+        std::call_once(registered, &register_halide_runtime);
+    }
+} cfg;
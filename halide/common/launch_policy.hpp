@@ -0,0 +1,217 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/future.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+
+#include "executor.hpp"
+#include "pipeline.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    // Decides how the kernel of a primitive is run once all of its operands
+    // have become available. The policy is read from the HPX configuration:
+    //
+    //   phylanx.halide.<primitive>.launch          = auto | async | fork | sync
+    //   phylanx.halide.<primitive>.async_threshold = <number of elements>
+    //
+    // 'auto' (the default) runs kernels touching fewer elements than the
+    // threshold inline on the thread that produced the last operand and
+    // spawns a new HPX thread for all larger ones, which allows independent
+    // nodes of an execution tree to overlap.
+    //
+    // Spawned kernels run on the kernel pool with the priority configured
+    // for the primitive (see executor.hpp).
+    class launch_policy
+    {
+    public:
+        enum launch_mode
+        {
+            automatic,
+            async,
+            fork,
+            sync
+        };
+
+        launch_policy(std::string const& primitive,
+            std::size_t default_threshold)
+          : mode_(automatic)
+          , threshold_(default_threshold)
+          , priority_(kernel_priority(primitive))
+        {
+            std::string const prefix = "phylanx.halide." + primitive;
+
+            std::string const mode =
+                hpx::get_config_entry(prefix + ".launch", "auto");
+            if (mode == "async")
+            {
+                mode_ = async;
+            }
+            else if (mode == "fork")
+            {
+                mode_ = fork;
+            }
+            else if (mode == "sync")
+            {
+                mode_ = sync;
+            }
+
+            threshold_ = parse_size(
+                hpx::get_config_entry(prefix + ".async_threshold", ""),
+                default_threshold);
+        }
+
+        launch_mode mode(std::size_t work) const
+        {
+            if (mode_ == automatic)
+            {
+                return work < threshold_ ? sync : async;
+            }
+            return mode_;
+        }
+
+        // Run f() with the launch mode selected for the given amount of
+        // work, the result is always delivered through a future.
+        template <typename F>
+        hpx::future<std::invoke_result_t<F&>> run(
+            std::size_t work, F&& f) const
+        {
+            using result_type = std::invoke_result_t<F&>;
+
+            switch (mode(work))
+            {
+            case async:
+                return hpx::async(
+                    kernel_executor(priority_), std::forward<F>(f));
+
+            case fork:
+                // a thread can't be forked onto another pool
+                if (kernel_pool() != hpx::this_thread::get_pool())
+                {
+                    return hpx::async(
+                        kernel_executor(priority_), std::forward<F>(f));
+                }
+                return hpx::async(
+                    hpx::launch::fork(priority_), std::forward<F>(f));
+
+            default:
+                break;
+            }
+
+            try
+            {
+                return hpx::make_ready_future(f());
+            }
+            catch (...)
+            {
+                return hpx::make_exceptional_future<result_type>(
+                    std::current_exception());
+            }
+        }
+
+    private:
+        launch_mode mode_;
+        std::size_t threshold_;
+        hpx::threads::thread_priority priority_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Number of elements of a numeric argument, scalars count as one element
+    // and all other arguments (strings, nil, ...) as none.
+    inline std::size_t element_count(
+        phylanx::execution_tree::primitive_argument_type const& val)
+    {
+        using namespace phylanx::execution_tree;
+
+        if (!is_numeric_operand(val) && !is_integer_operand(val) &&
+            !is_boolean_operand(val))
+        {
+            return 0;
+        }
+
+        std::size_t const ndim = extract_numeric_value_dimension(val);
+        auto const dims = extract_numeric_value_dimensions(val);
+
+        std::size_t count = 1;
+        for (std::size_t i = 0; i != ndim; ++i)
+        {
+            count *= dims[i];
+        }
+        return count;
+    }
+
+    // Evaluate all operands of a primitive.
+    inline std::vector<
+        hpx::future<phylanx::execution_tree::primitive_argument_type>>
+    operand_values(
+        phylanx::execution_tree::primitive_arguments_type const& operands,
+        phylanx::execution_tree::primitive_arguments_type const& args,
+        std::string const& name, std::string const& codename,
+        phylanx::execution_tree::eval_context const& ctx)
+    {
+        std::vector<
+            hpx::future<phylanx::execution_tree::primitive_argument_type>>
+            values;
+        values.reserve(operands.size());
+        for (auto const& operand : operands)
+        {
+            values.push_back(phylanx::execution_tree::value_operand(
+                operand, args, name, codename, ctx));
+        }
+        return values;
+    }
+
+    // Invoke f with the values of all operands once they are ready, using
+    // the launch mode the policy selects for the number of elements of all
+    // operands.
+    template <typename F>
+    hpx::future<phylanx::execution_tree::primitive_argument_type>
+    launch_kernel(launch_policy const& policy, F&& f,
+        std::vector<
+            hpx::future<phylanx::execution_tree::primitive_argument_type>>&&
+            values)
+    {
+        using phylanx::execution_tree::primitive_argument_type;
+        using phylanx::execution_tree::primitive_arguments_type;
+
+        return hpx::future<primitive_argument_type>(hpx::dataflow(
+            hpx::launch::sync,
+            [&policy, f = std::forward<F>(f)](
+                std::vector<hpx::future<primitive_argument_type>>&&
+                    values) mutable -> hpx::future<primitive_argument_type> {
+                primitive_arguments_type args;
+                args.reserve(values.size());
+
+                std::size_t work = 0;
+                for (auto& value : values)
+                {
+                    args.push_back(value.get());
+                    work += element_count(args.back());
+                }
+
+                return policy.run(work,
+                    [f = std::move(f), args = std::move(args)]() mutable
+                    -> primitive_argument_type {
+                        return f(std::move(args));
+                    });
+            },
+            std::move(values)));
+    }
+}
@@ -0,0 +1,259 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "executor.hpp"
+#include "par_for.hpp"
+#include "pipeline.hpp"
+#include "trace.hpp"
+
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threadmanager.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        // adaptive chunks aim for this much work per HPX thread
+        constexpr double adaptive_chunk_time = 50e-6;
+
+        // How loops nested into parallel work are run
+        struct nesting_policy
+        {
+            enum nesting
+            {
+                parallel,
+                sequential,
+                bounded
+            };
+
+            nesting kind;
+            std::size_t max_tasks;
+        };
+
+        nesting_policy read_nesting_policy()
+        {
+            std::string const spec = hpx::get_config_entry(
+                "phylanx.halide.nested_parallelism", "bounded");
+            std::string const name = spec.substr(0, spec.find(':'));
+            if (name == "parallel")
+            {
+                return nesting_policy{nesting_policy::parallel, 0};
+            }
+            if (name == "sequential")
+            {
+                return nesting_policy{nesting_policy::sequential, 0};
+            }
+
+            std::size_t max_tasks = 4;
+            if (name.size() != spec.size())
+            {
+                max_tasks = (std::max)(std::size_t(1),
+                    parse_size(spec.substr(name.size() + 1), max_tasks));
+            }
+            return nesting_policy{nesting_policy::bounded, max_tasks};
+        }
+
+        nesting_policy const& get_nesting_policy()
+        {
+            static nesting_policy const policy = read_nesting_policy();
+            return policy;
+        }
+
+        // A loop is nested if it is run from an iteration of another
+        // parallel loop (or a task) of the Halide runtime, or if all cores
+        // already have work queued (e.g. the pipeline is run from a
+        // parallel loop of the caller).
+        bool is_nested()
+        {
+            if (current_nesting_depth() != 0)
+            {
+                return true;
+            }
+            return hpx::threads::get_thread_count(
+                       hpx::threads::thread_schedule_state::pending) >=
+                std::int64_t(hpx::get_os_thread_count());
+        }
+
+        int run_sequential(void* ctx, loop_body_type f, int min, int extent,
+            std::uint8_t* closure)
+        {
+            for (int i = min; i != min + extent; ++i)
+            {
+                int const r = f(ctx, i, closure);
+                if (r != 0)
+                {
+                    return r;
+                }
+            }
+            return 0;
+        }
+
+        template <typename Policy>
+        int run_loop(Policy&& policy, void* ctx, loop_body_type f, int min,
+            int extent, std::uint8_t* closure)
+        {
+            std::size_t const data = nested_pipeline_data();
+
+            // the iterations run on the kernel pool, with the priority of
+            // the pipeline
+            pipeline_state& pipeline = current_pipeline();
+            auto exec = kernel_executor(pipeline.priority());
+
+            // the iterations are annotated with the name of the pipeline
+            char const* const name = pipeline.name().empty() ?
+                "halide_hpx_for" :
+                pipeline.name().c_str();
+
+#if defined(PHYLANX_HALIDE_HAVE_TRACING)
+            trace_recorder& recorder = trace_recorder::instance();
+            bool const trace = recorder.enabled();
+#endif
+
+            // report the first error of any iteration
+            std::atomic<int> result(0);
+            hpx::for_loop(std::forward<Policy>(policy).on(exec), min,
+                min + extent,
+                hpx::util::annotated_function(
+                    [&](int i) {
+                        // loops nested into this one run in the same pipeline
+                        // and know that they are nested
+                        pipeline_data_scope scope(data);
+
+#if defined(PHYLANX_HALIDE_HAVE_TRACING)
+                        auto const begin = trace_recorder::clock::now();
+#endif
+                        int const r = f(ctx, i, closure);
+                        if (r != 0)
+                        {
+                            int expected = 0;
+                            result.compare_exchange_strong(expected, r);
+                        }
+#if defined(PHYLANX_HALIDE_HAVE_TRACING)
+                        if (trace)
+                        {
+                            recorder.add_span(name, "par_for", begin,
+                                trace_recorder::clock::now());
+                        }
+#endif
+                    },
+                    name));
+            return result;
+        }
+
+        int run_adaptive(void* ctx, loop_body_type f, int min, int extent,
+            std::uint8_t* closure, chunking_policy* chunking)
+        {
+            std::size_t const threads = hpx::get_os_thread_count();
+            std::size_t const max_chunk =
+                (std::max)(std::size_t(1), (extent + threads - 1) / threads);
+
+            // without an estimate start with four chunks per core
+            std::size_t chunk = (std::max)(
+                std::size_t(1), std::size_t(extent) / (4 * threads));
+            double const cost = chunking->cost(f);
+            if (cost > 0.0)
+            {
+                chunk = (std::min)(max_chunk,
+                    (std::max)(std::size_t(1),
+                        std::size_t(adaptive_chunk_time / cost)));
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            int const result = run_loop(
+                hpx::execution::par.with(
+                    hpx::execution::static_chunk_size(chunk)),
+                ctx, f, min, extent, closure);
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+
+            // all busy cores contributed to the elapsed time
+            std::size_t const chunks = (extent + chunk - 1) / chunk;
+            double const busy = double((std::min)(threads, chunks));
+            chunking->update_cost(f, elapsed.count() * busy / extent);
+
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    int do_par_for(void* ctx, int (*f)(void*, int, std::uint8_t*), int min,
+        int extent, std::uint8_t* closure)
+    {
+        if (extent <= 0)
+        {
+            return 0;
+        }
+
+        current_pipeline().count_par_for_tasks(extent);
+
+        // nested loops don't oversubscribe the cores
+        if (extent > 1 && is_nested())
+        {
+            nesting_policy const& nesting = get_nesting_policy();
+            if (nesting.kind == nesting_policy::sequential)
+            {
+                return run_sequential(ctx, f, min, extent, closure);
+            }
+            if (nesting.kind == nesting_policy::bounded &&
+                std::size_t(extent) > nesting.max_tasks)
+            {
+                std::size_t const chunk =
+                    (extent + nesting.max_tasks - 1) / nesting.max_tasks;
+                return run_loop(hpx::execution::par.with(
+                                    hpx::execution::static_chunk_size(chunk)),
+                    ctx, f, min, extent, closure);
+            }
+        }
+
+        chunking_policy* chunking = &current_pipeline().chunking();
+        switch (chunking->kind())
+        {
+        case chunking_policy::static_size:
+            if (chunking->chunk_size() != 0)
+            {
+                return run_loop(
+                    hpx::execution::par.with(hpx::execution::static_chunk_size(
+                        chunking->chunk_size())),
+                    ctx, f, min, extent, closure);
+            }
+            return run_loop(
+                hpx::execution::par.with(hpx::execution::static_chunk_size()),
+                ctx, f, min, extent, closure);
+
+        case chunking_policy::guided:
+            return run_loop(
+                hpx::execution::par.with(hpx::execution::guided_chunk_size()),
+                ctx, f, min, extent, closure);
+
+        case chunking_policy::automatic:
+            return run_loop(
+                hpx::execution::par.with(hpx::execution::auto_chunk_size()),
+                ctx, f, min, extent, closure);
+
+        case chunking_policy::adaptive:
+            return run_adaptive(ctx, f, min, extent, closure, chunking);
+
+        default:
+            break;
+        }
+
+        return run_loop(
+            hpx::execution::par, ctx, f, min, extent, closure);
+    }
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "pipeline.hpp"
+
+#include <cstdint>
+
+namespace phylanx_halide_common {
+
+    // The parallel loops of the Halide pipelines run on hpx::for_loop. How
+    // the iterations are grouped into HPX threads is read from the HPX
+    // configuration, per pipeline:
+    //
+    //   phylanx.halide.<pipeline>.chunking = <policy>
+    //   phylanx.halide.chunking            = <policy> (all other pipelines)
+    //
+    // where <policy> is one of
+    //
+    //   default     the default chunking of hpx::for_loop
+    //   static[:N]  chunks of N iterations (default: an even split)
+    //   guided      chunks shrinking with the number of remaining iterations
+    //   auto        the chunk size is derived from timing a few iterations
+    //   adaptive    the chunk size is derived from the measured cost of the
+    //               previous runs of the same loop
+    //
+    // The policy of a pipeline applies to all loops executed while a
+    // pipeline_scope for it is alive on the current HPX thread (including
+    // the loops nested into those).
+    //
+    // Loops run from within parallel work (an iteration of another parallel
+    // loop or task of the runtime, or while all cores have work queued) are
+    // limited by 'phylanx.halide.nested_parallelism':
+    //
+    //   parallel     no limit, the pipeline policy applies
+    //   sequential   the iterations run on the calling thread
+    //   bounded[:N]  at most N chunks (default: 4)
+    int do_par_for(void* ctx, int (*f)(void*, int, std::uint8_t*), int min,
+        int extent, std::uint8_t* closure);
+}
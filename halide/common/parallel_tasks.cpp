@@ -0,0 +1,234 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "executor.hpp"
+#include "parallel_tasks.hpp"
+#include "pipeline.hpp"
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/lcos_local.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/include/util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        // the counter lives in the opaque storage of halide_semaphore_t
+        using semaphore_counter = std::atomic<std::int64_t>;
+
+        static_assert(sizeof(semaphore_counter) <= sizeof(halide_semaphore_t),
+            "halide_semaphore_t is too small to hold the counter");
+        static_assert(
+            alignof(semaphore_counter) <= alignof(halide_semaphore_t),
+            "halide_semaphore_t is not suitably aligned for the counter");
+
+        semaphore_counter& counter(halide_semaphore_t* sema)
+        {
+            return *reinterpret_cast<semaphore_counter*>(sema->_private);
+        }
+
+        // halide_semaphore_t is too small to hold a condition variable, the
+        // waiters of a semaphore are suspended on the condition variable of
+        // one of a fixed number of stripes selected by its address
+        struct alignas(64) wait_stripe
+        {
+            hpx::lcos::local::mutex mtx;
+            hpx::lcos::local::condition_variable cv;
+            std::atomic<std::int64_t> waiters{0};
+        };
+
+        constexpr std::size_t num_wait_stripes = 64;
+
+        wait_stripe& stripe_of(halide_semaphore_t* sema)
+        {
+            static wait_stripe stripes[num_wait_stripes];
+            return stripes[(reinterpret_cast<std::uintptr_t>(sema) /
+                               sizeof(halide_semaphore_t)) %
+                num_wait_stripes];
+        }
+
+        // Acquire all semaphores of a task or none of them, returns the index
+        // of the semaphore that could not be acquired or -1.
+        int try_acquire_all(halide_parallel_task_t const& task)
+        {
+            for (int i = 0; i != task.num_semaphores; ++i)
+            {
+                auto const& acquire = task.semaphores[i];
+                if (!semaphore_try_acquire(acquire.semaphore, acquire.count))
+                {
+                    // give back what was acquired so far
+                    for (int j = 0; j != i; ++j)
+                    {
+                        semaphore_release(task.semaphores[j].semaphore,
+                            task.semaphores[j].count);
+                    }
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        // Suspends the calling HPX thread until the semaphore that blocked
+        // the task was released, the producers run on the freed core.
+        void acquire_all(halide_parallel_task_t const& task)
+        {
+            for (int blocked = try_acquire_all(task); blocked != -1;
+                 blocked = try_acquire_all(task))
+            {
+                auto const& acquire = task.semaphores[blocked];
+                wait_stripe& stripe = stripe_of(acquire.semaphore);
+
+                std::unique_lock<hpx::lcos::local::mutex> l(stripe.mtx);
+                ++stripe.waiters;
+                while (counter(acquire.semaphore).load() < acquire.count)
+                {
+                    stripe.cv.wait(l);
+                }
+                --stripe.waiters;
+            }
+        }
+
+        // Run all iterations of a task, each iteration acquires the
+        // semaphores of the task first. Serial tasks run their iterations
+        // in order, all others may run them concurrently.
+        int run_task(void* ctx, halide_parallel_task_t const& task,
+            void* task_parent, std::size_t data)
+        {
+            pipeline_data_scope scope(data);
+
+            if (task.serial)
+            {
+                for (int i = task.min; i != task.min + task.extent; ++i)
+                {
+                    acquire_all(task);
+                    int const r = task.fn(ctx, i, 1, task.closure, task_parent);
+                    if (r != 0)
+                    {
+                        return r;
+                    }
+                }
+                return 0;
+            }
+
+            std::atomic<int> result(0);
+            hpx::for_loop(hpx::execution::par.on(kernel_executor(
+                              current_pipeline().priority())),
+                task.min, task.min + task.extent,
+                hpx::util::annotated_function(
+                    [&](int i) {
+                        pipeline_data_scope scope(data);
+
+                        acquire_all(task);
+                        int const r =
+                            task.fn(ctx, i, 1, task.closure, task_parent);
+                        if (r != 0)
+                        {
+                            int expected = 0;
+                            result.compare_exchange_strong(expected, r);
+                        }
+                    },
+                    task.name != nullptr ? task.name : "halide_hpx_task"));
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    int do_task(void* ctx, halide_task_t f, int idx, std::uint8_t* closure)
+    {
+        return f(ctx, idx, closure);
+    }
+
+    int do_loop_task(void* ctx, halide_loop_task_t f, int min, int extent,
+        std::uint8_t* closure, void* task_parent)
+    {
+        return f(ctx, min, extent, closure, task_parent);
+    }
+
+    // All tasks are started as separate HPX threads (the last one runs on
+    // the calling thread), producers and consumers thus run concurrently
+    // even if their number exceeds the number of cores.
+    int do_parallel_tasks(void* ctx, int num_tasks,
+        halide_parallel_task_t* tasks, void* task_parent)
+    {
+        if (num_tasks <= 0)
+        {
+            return 0;
+        }
+
+        // the tasks run one level of nesting deeper than the caller
+        std::size_t const data = nested_pipeline_data();
+
+        auto exec = kernel_executor(current_pipeline().priority());
+
+        std::vector<hpx::future<int>> results;
+        results.reserve(num_tasks - 1);
+        for (int i = 0; i != num_tasks - 1; ++i)
+        {
+            halide_parallel_task_t const* task = &tasks[i];
+            results.push_back(hpx::async(exec, [=]() {
+                return run_task(ctx, *task, task_parent, data);
+            }));
+        }
+
+        int result = run_task(ctx, tasks[num_tasks - 1], task_parent, data);
+
+        for (auto& f : results)
+        {
+            int const r = f.get();
+            if (result == 0)
+            {
+                result = r;
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    int semaphore_init(halide_semaphore_t* sema, int count)
+    {
+        new (sema->_private) semaphore_counter(count);
+        return count;
+    }
+
+    int semaphore_release(halide_semaphore_t* sema, int count)
+    {
+        int const value = int(counter(sema).fetch_add(count) + count);
+
+        // a waiter registers before it checks the counter, thus either it
+        // sees the new value or the waiter is seen here
+        wait_stripe& stripe = stripe_of(sema);
+        if (stripe.waiters.load() != 0)
+        {
+            std::lock_guard<hpx::lcos::local::mutex> l(stripe.mtx);
+            stripe.cv.notify_all();
+        }
+        return value;
+    }
+
+    bool semaphore_try_acquire(halide_semaphore_t* sema, int count)
+    {
+        semaphore_counter& c = counter(sema);
+        std::int64_t value = c.load(std::memory_order_relaxed);
+        while (value >= count)
+        {
+            if (c.compare_exchange_weak(value, value - count))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,30 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <HalideRuntime.h>
+
+#include <cstdint>
+
+namespace phylanx_halide_common {
+
+    // The task hooks of the Halide runtime implemented on HPX threads. These
+    // are used by pipelines scheduled with async() producers and by nested
+    // task graphs. Tasks waiting for a semaphore suspend their HPX thread on
+    // a condition variable until the semaphore is released, such that the
+    // producers they depend on make progress on the same cores.
+    int do_task(void* ctx, halide_task_t f, int idx, std::uint8_t* closure);
+
+    int do_loop_task(void* ctx, halide_loop_task_t f, int min, int extent,
+        std::uint8_t* closure, void* task_parent);
+
+    int do_parallel_tasks(void* ctx, int num_tasks,
+        halide_parallel_task_t* tasks, void* task_parent);
+
+    int semaphore_init(halide_semaphore_t* sema, int count);
+    int semaphore_release(halide_semaphore_t* sema, int count);
+    bool semaphore_try_acquire(halide_semaphore_t* sema, int count);
+}
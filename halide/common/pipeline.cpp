@@ -0,0 +1,246 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "executor.hpp"
+#include "pipeline.hpp"
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        // weight of the latest measurement in the cost estimate
+        constexpr double adaptive_weight = 0.25;
+
+        // the nesting depth is kept in the low bits of the thread data
+        constexpr std::size_t depth_mask = alignof(pipeline_state) - 1;
+
+        std::string chunking_spec(std::string const& pipeline)
+        {
+            std::string spec = hpx::get_config_entry(
+                "phylanx.halide." + pipeline + ".chunking", "");
+            if (spec.empty())
+            {
+                spec = hpx::get_config_entry(
+                    "phylanx.halide.chunking", "default");
+            }
+            return spec;
+        }
+
+        class pipeline_registry
+        {
+        public:
+            static pipeline_registry& instance()
+            {
+                static pipeline_registry registry;
+                return registry;
+            }
+
+            pipeline_state* get(std::string const& pipeline)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                auto it = pipelines_.find(pipeline);
+                if (it == pipelines_.end())
+                {
+                    it = pipelines_
+                             .emplace(pipeline,
+                                 std::make_unique<pipeline_state>(pipeline))
+                             .first;
+                }
+                return it->second.get();
+            }
+
+            std::vector<pipeline_state*> all()
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                std::vector<pipeline_state*> result;
+                result.reserve(pipelines_.size());
+                for (auto const& p : pipelines_)
+                {
+                    result.push_back(p.second.get());
+                }
+                return result;
+            }
+
+        private:
+            std::mutex mtx_;
+            std::map<std::string, std::unique_ptr<pipeline_state>> pipelines_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t parse_size(std::string const& value, std::size_t default_value)
+    {
+        // strtoull silently wraps negative numbers around
+        if (value.find('-') != std::string::npos)
+        {
+            return default_value;
+        }
+
+        char* end = nullptr;
+        errno = 0;
+        unsigned long long const result =
+            std::strtoull(value.c_str(), &end, 10);
+        if (errno != 0 || end == value.c_str() || *end != '\0')
+        {
+            return default_value;
+        }
+        return std::size_t(result);
+    }
+
+    chunking_policy::chunking_policy(std::string const& spec)
+      : kind_(hpx_default)
+      , chunk_size_(0)
+    {
+        std::string const name = spec.substr(0, spec.find(':'));
+        if (name == "static")
+        {
+            kind_ = static_size;
+            if (name.size() != spec.size())
+            {
+                chunk_size_ = parse_size(spec.substr(name.size() + 1), 0);
+            }
+        }
+        else if (name == "guided")
+        {
+            kind_ = guided;
+        }
+        else if (name == "auto")
+        {
+            kind_ = automatic;
+        }
+        else if (name == "adaptive")
+        {
+            kind_ = adaptive;
+        }
+    }
+
+    double chunking_policy::cost(loop_body_type f) const
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        auto it = costs_.find(f);
+        return it != costs_.end() ? it->second : 0.0;
+    }
+
+    void chunking_policy::update_cost(loop_body_type f, double cost)
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        auto it = costs_.find(f);
+        if (it == costs_.end())
+        {
+            costs_.emplace(f, cost);
+        }
+        else
+        {
+            it->second += adaptive_weight * (cost - it->second);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    pipeline_state::pipeline_state(std::string const& name)
+      : name_(name)
+      , chunking_(chunking_spec(name))
+      , priority_(kernel_priority(name))
+      , allocations_(0)
+      , allocated_bytes_(0)
+      , system_allocations_(0)
+      , calls_(0)
+      , time_(0)
+      , flops_(0)
+      , bytes_(0)
+      , par_for_tasks_(0)
+    {
+    }
+
+    pipeline_state& get_pipeline(std::string const& name)
+    {
+        return *pipeline_registry::instance().get(name);
+    }
+
+    pipeline_state& current_pipeline()
+    {
+        std::size_t const data = current_pipeline_data() & ~depth_mask;
+        if (data != 0)
+        {
+            return *reinterpret_cast<pipeline_state*>(data);
+        }
+        return *pipeline_registry::instance().get("");
+    }
+
+    std::vector<pipeline_state*> pipelines()
+    {
+        return pipeline_registry::instance().all();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    pipeline_scope::pipeline_scope(char const* pipeline)
+      : previous_(0)
+    {
+        if (hpx::threads::get_self_ptr() != nullptr)
+        {
+            // the depth is kept, a pipeline run from within a parallel loop
+            // is still nested
+            std::size_t const depth = current_pipeline_data() & depth_mask;
+            previous_ = hpx::threads::set_thread_data(
+                hpx::threads::get_self_id(),
+                reinterpret_cast<std::size_t>(
+                    pipeline_registry::instance().get(pipeline)) |
+                    depth);
+        }
+    }
+
+    pipeline_scope::~pipeline_scope()
+    {
+        if (hpx::threads::get_self_ptr() != nullptr)
+        {
+            hpx::threads::set_thread_data(
+                hpx::threads::get_self_id(), previous_);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t current_pipeline_data()
+    {
+        if (hpx::threads::get_self_ptr() == nullptr)
+        {
+            return 0;
+        }
+        return hpx::threads::get_thread_data(hpx::threads::get_self_id());
+    }
+
+    void set_current_pipeline_data(std::size_t data)
+    {
+        if (hpx::threads::get_self_ptr() != nullptr)
+        {
+            hpx::threads::set_thread_data(hpx::threads::get_self_id(), data);
+        }
+    }
+
+    std::size_t nested_pipeline_data()
+    {
+        std::size_t const data = current_pipeline_data();
+        std::size_t const depth = data & depth_mask;
+        return reinterpret_cast<std::size_t>(&current_pipeline()) |
+            (depth != depth_mask ? depth + 1 : depth);
+    }
+
+    std::size_t current_nesting_depth()
+    {
+        return current_pipeline_data() & depth_mask;
+    }
+}
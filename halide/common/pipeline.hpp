@@ -0,0 +1,226 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/include/threads.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    using loop_body_type = int (*)(void*, int, std::uint8_t*);
+
+    // The number given by a configuration value, or default_value if the
+    // value is empty or not a valid non-negative number. This never throws,
+    // the settings are read from within the hooks of the Halide runtime.
+    std::size_t parse_size(std::string const& value, std::size_t default_value);
+
+    // How the iterations of a parallel Halide loop are grouped into HPX
+    // threads (see par_for.hpp for the configuration).
+    class chunking_policy
+    {
+    public:
+        enum chunking
+        {
+            hpx_default,
+            static_size,
+            guided,
+            automatic,
+            adaptive
+        };
+
+        explicit chunking_policy(std::string const& spec);
+
+        chunking kind() const
+        {
+            return kind_;
+        }
+
+        std::size_t chunk_size() const
+        {
+            return chunk_size_;
+        }
+
+        // estimated time per iteration of the given loop, zero if the loop
+        // has not been run yet
+        double cost(loop_body_type f) const;
+        void update_cost(loop_body_type f, double cost);
+
+    private:
+        chunking kind_;
+        std::size_t chunk_size_;
+
+        mutable std::mutex mtx_;
+        std::map<loop_body_type, double> costs_;
+    };
+
+    // Memory a pipeline allocated through halide_malloc.
+    struct allocation_statistics
+    {
+        std::uint64_t allocations;           // number of requests
+        std::uint64_t bytes;                 // bytes requested
+        std::uint64_t system_allocations;    // requests the arena missed
+    };
+
+    // The calls of a kernel and their cost, the FLOPs and bytes are estimated
+    // from the shapes of the operands.
+    struct kernel_statistics
+    {
+        std::uint64_t calls;
+        std::uint64_t time;             // wall time [ns]
+        std::uint64_t flops;
+        std::uint64_t bytes;            // bytes read and written
+        std::uint64_t par_for_tasks;    // iterations of parallel loops
+    };
+
+    // The policies and statistics of a pipeline. They are created on first
+    // use and live as long as the process, such that HPX threads can refer
+    // to them through their thread data. The low bits of the (aligned)
+    // reference hold the nesting depth of the thread.
+    class alignas(64) pipeline_state
+    {
+    public:
+        explicit pipeline_state(std::string const& name);
+
+        std::string const& name() const
+        {
+            return name_;
+        }
+
+        chunking_policy& chunking()
+        {
+            return chunking_;
+        }
+
+        // the priority of the HPX threads running its parallel loops and
+        // tasks (see executor.hpp)
+        hpx::threads::thread_priority priority() const
+        {
+            return priority_;
+        }
+
+        void count_allocation(std::size_t bytes, bool system)
+        {
+            ++allocations_;
+            allocated_bytes_ += bytes;
+            if (system)
+            {
+                ++system_allocations_;
+            }
+        }
+
+        allocation_statistics get_allocation_statistics() const
+        {
+            return allocation_statistics{
+                allocations_, allocated_bytes_, system_allocations_};
+        }
+
+        void count_call(std::uint64_t time, double flops, double bytes)
+        {
+            ++calls_;
+            time_ += time;
+            flops_ += std::uint64_t(flops);
+            bytes_ += std::uint64_t(bytes);
+        }
+
+        void count_par_for_tasks(std::uint64_t tasks)
+        {
+            par_for_tasks_ += tasks;
+        }
+
+        kernel_statistics get_kernel_statistics() const
+        {
+            return kernel_statistics{
+                calls_, time_, flops_, bytes_, par_for_tasks_};
+        }
+
+    private:
+        std::string const name_;
+        chunking_policy chunking_;
+        hpx::threads::thread_priority const priority_;
+
+        std::atomic<std::uint64_t> allocations_;
+        std::atomic<std::uint64_t> allocated_bytes_;
+        std::atomic<std::uint64_t> system_allocations_;
+
+        std::atomic<std::uint64_t> calls_;
+        std::atomic<std::uint64_t> time_;
+        std::atomic<std::uint64_t> flops_;
+        std::atomic<std::uint64_t> bytes_;
+        std::atomic<std::uint64_t> par_for_tasks_;
+    };
+
+    // The state of the named pipeline.
+    pipeline_state& get_pipeline(std::string const& name);
+
+    // The pipeline run by the current HPX thread, the state with an empty
+    // name stands for all code run outside of any pipeline_scope.
+    pipeline_state& current_pipeline();
+
+    // All pipelines seen so far.
+    std::vector<pipeline_state*> pipelines();
+
+    // Make the named pipeline the current one of this HPX thread while the
+    // scope is alive. HPX threads spawned by the runtime bridge for its
+    // parallel loops and tasks inherit it.
+    class pipeline_scope
+    {
+    public:
+        explicit pipeline_scope(char const* pipeline);
+        ~pipeline_scope();
+
+        pipeline_scope(pipeline_scope const&) = delete;
+        pipeline_scope& operator=(pipeline_scope const&) = delete;
+
+    private:
+        std::size_t previous_;
+    };
+
+    // The (opaque) pipeline reference stored in the thread data of the
+    // current HPX thread, to be passed on to the threads it spawns.
+    std::size_t current_pipeline_data();
+    void set_current_pipeline_data(std::size_t data);
+
+    // Make the given reference the one of the current HPX thread while the
+    // scope is alive and restore the previous one afterwards. Iterations
+    // run inline on the calling thread must not leave their nesting depth
+    // behind.
+    class pipeline_data_scope
+    {
+    public:
+        explicit pipeline_data_scope(std::size_t data)
+          : previous_(current_pipeline_data())
+        {
+            set_current_pipeline_data(data);
+        }
+
+        ~pipeline_data_scope()
+        {
+            set_current_pipeline_data(previous_);
+        }
+
+        pipeline_data_scope(pipeline_data_scope const&) = delete;
+        pipeline_data_scope& operator=(pipeline_data_scope const&) = delete;
+
+    private:
+        std::size_t previous_;
+    };
+
+    // The reference to pass on to the HPX threads running the iterations of
+    // a parallel loop or the tasks started by the current thread: the same
+    // pipeline, one level of nesting deeper.
+    std::size_t nested_pipeline_data();
+
+    // The number of parallel loops and tasks of the Halide runtime the
+    // current HPX thread is nested into.
+    std::size_t current_nesting_depth();
+}
@@ -0,0 +1,206 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/runtime.hpp>
+
+#include "buffer_pool.hpp"
+#include "counters.hpp"
+#include "pipeline.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    // A pool of the result arrays handed to Phylanx. Phylanx frees a result
+    // when it drops the last reference to it without telling the plugins,
+    // but the operands a primitive consumes are owned by the primitive unless
+    // they reference a variable or an array of the caller. The storage of
+    // those is released into the pool and serves the next result of a
+    // fitting size, which then neither allocates nor page faults. In a chain
+    // of primitives processing a stream of frames, the result of one
+    // primitive is the consumed operand of the next one, and the same few
+    // arrays are recycled frame after frame.
+    //
+    // A released array serves the results needing between half and all of
+    // its capacity. The memory held is limited by
+    // 'phylanx.halide.result_pool.max_bytes' (default: 256 MiB), arrays
+    // beyond that are freed. The hits, misses and cached bytes are reported
+    // by the HPX performance counters /halide/result_pool/*.
+    class result_pool
+    {
+    public:
+        using matrix_type = blaze::DynamicMatrix<double>;
+        using tensor_type = blaze::DynamicTensor<double>;
+
+        static result_pool& instance()
+        {
+            static result_pool pool;
+            return pool;
+        }
+
+        // arrays of the given size, their elements are not initialized
+        matrix_type matrix(std::size_t rows, std::size_t columns)
+        {
+            matrix_type result = acquire(matrices_, rows * padded(columns));
+            result.resize(rows, columns, false);
+            return result;
+        }
+
+        tensor_type tensor(
+            std::size_t pages, std::size_t rows, std::size_t columns)
+        {
+            tensor_type result =
+                acquire(tensors_, pages * rows * padded(columns));
+            result.resize(pages, rows, columns, false);
+            return result;
+        }
+
+        void release(matrix_type&& m)
+        {
+            release(matrices_, std::move(m));
+        }
+
+        void release(tensor_type&& t)
+        {
+            release(tensors_, std::move(t));
+        }
+
+        // release the storage of a consumed operand, operands referencing
+        // data of the caller are left alone
+        void release(phylanx::ir::node_data<double>&& data)
+        {
+            if (data.is_ref())
+            {
+                return;
+            }
+
+            switch (data.num_dimensions())
+            {
+            case 2:
+                release(std::move(data.matrix_non_ref()));
+                break;
+
+            case 3:
+                release(std::move(data.tensor_non_ref()));
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        // the operands of other types can't hold a result
+        template <typename T>
+        void release(phylanx::ir::node_data<T>&&)
+        {
+        }
+
+        pool_statistics get_statistics() const
+        {
+            return pool_statistics{hits_, misses_, cached_};
+        }
+
+    private:
+        template <typename Array>
+        struct free_list
+        {
+            std::mutex mtx;
+            std::vector<Array> arrays;
+        };
+
+        result_pool()
+          : max_cached_(parse_size(
+                hpx::get_config_entry(
+                    "phylanx.halide.result_pool.max_bytes", ""),
+                std::size_t(256) << 20))
+          , hits_(0)
+          , misses_(0)
+          , cached_(0)
+        {
+        }
+
+        // the elements of a row of the given length including the padding
+        static std::size_t padded(std::size_t columns)
+        {
+            return blaze::usePadding ?
+                blaze::nextMultiple(columns, blaze::SIMDTrait<double>::size) :
+                columns;
+        }
+
+        template <typename Array>
+        Array acquire(free_list<Array>& list, std::size_t elements)
+        {
+            {
+                std::lock_guard<std::mutex> l(list.mtx);
+                for (auto it = list.arrays.begin(); it != list.arrays.end();
+                     ++it)
+                {
+                    std::size_t const capacity = it->capacity();
+                    if (capacity >= elements && capacity / 2 <= elements)
+                    {
+                        Array result(std::move(*it));
+                        list.arrays.erase(it);
+
+                        ++hits_;
+                        cached_ -= capacity * sizeof(double);
+                        return result;
+                    }
+                }
+            }
+
+            ++misses_;
+            return Array();
+        }
+
+        template <typename Array>
+        void release(free_list<Array>& list, Array&& array)
+        {
+            Array released(std::move(array));
+            std::size_t const bytes = released.capacity() * sizeof(double);
+            if (bytes == 0)
+            {
+                return;
+            }
+
+            // arrays exceeding the limit are freed, the bytes are reserved
+            // first such that concurrent releases can't overshoot the limit
+            // together
+            if (cached_.fetch_add(bytes) + bytes > max_cached_)
+            {
+                cached_ -= bytes;
+                return;
+            }
+
+            std::lock_guard<std::mutex> l(list.mtx);
+            list.arrays.push_back(std::move(released));
+        }
+
+        free_list<matrix_type> matrices_;
+        free_list<tensor_type> tensors_;
+        std::size_t const max_cached_;
+
+        std::atomic<std::uint64_t> hits_;
+        std::atomic<std::uint64_t> misses_;
+        std::atomic<std::uint64_t> cached_;
+    };
+
+    // install_pool_counters for the result pool
+    inline void install_result_pool_counters()
+    {
+        install_pool_counters("result_pool",
+            [] { return result_pool::instance().get_statistics(); });
+    }
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include "trace.hpp"
+
+#include <hpx/include/runtime.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace phylanx_halide_common {
+
+    namespace {
+
+        std::int64_t nanoseconds(trace_recorder::clock::duration d)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(d)
+                .count();
+        }
+
+        // the names are Func and pipeline names, quote them anyway
+        std::string escape(std::string const& name)
+        {
+            std::string result;
+            result.reserve(name.size());
+            for (char c : name)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    result += '\\';
+                }
+                result += c;
+            }
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    trace_recorder& trace_recorder::instance()
+    {
+        static trace_recorder recorder;
+        return recorder;
+    }
+
+    trace_recorder::trace_recorder()
+      : file_(hpx::get_config_entry("phylanx.halide.trace.file", ""))
+      , start_(clock::now())
+      , next_id_(1)
+    {
+        std::size_t const num_lists = hpx::get_os_thread_count() + 1;
+
+        lists_.reserve(num_lists);
+        for (std::size_t i = 0; i != num_lists; ++i)
+        {
+            lists_.push_back(std::make_unique<span_list>());
+        }
+
+        if (enabled())
+        {
+            hpx::register_shutdown_function([]() { instance().write(); });
+        }
+    }
+
+    void trace_recorder::add_span(std::string name, char const* category,
+        clock::time_point begin, clock::time_point end)
+    {
+        std::size_t list = hpx::get_worker_thread_num();
+        if (list >= lists_.size() - 1)
+        {
+            list = lists_.size() - 1;
+        }
+
+        span_list& spans = *lists_[list];
+        std::lock_guard<std::mutex> l(spans.mtx);
+        spans.spans.push_back(span{std::move(name), category,
+            nanoseconds(begin - start_), nanoseconds(end - start_)});
+    }
+
+    void trace_recorder::write() const
+    {
+        std::ofstream out(file_);
+        if (!out)
+        {
+            return;
+        }
+
+        std::uint32_t const pid = hpx::get_locality_id();
+        char const* separator = "";
+
+        out << "{\"traceEvents\":[\n";
+        for (std::size_t i = 0; i != lists_.size(); ++i)
+        {
+            std::string const thread = (i + 1 == lists_.size()) ?
+                std::string("other threads") :
+                "worker#" + std::to_string(i);
+            out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\","
+                << "\"pid\":" << pid << ",\"tid\":" << i
+                << ",\"args\":{\"name\":\"" << thread << "\"}}";
+            separator = ",\n";
+
+            std::lock_guard<std::mutex> l(lists_[i]->mtx);
+            for (span const& s : lists_[i]->spans)
+            {
+                out << separator << "{\"name\":\"" << escape(s.name)
+                    << "\",\"cat\":\"" << s.category << "\",\"ph\":\"X\","
+                    << "\"pid\":" << pid << ",\"tid\":" << i
+                    << ",\"ts\":" << s.begin / 1e3
+                    << ",\"dur\":" << (s.end - s.begin) / 1e3 << "}";
+            }
+        }
+        out << "\n]}\n";
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    int trace_recorder::begin_event(std::string name, char const* category)
+    {
+        std::lock_guard<std::mutex> l(pending_mtx_);
+        int const id = next_id_++;
+        pending_.emplace(
+            id, pending_event{std::move(name), category, clock::now()});
+        return id;
+    }
+
+    void trace_recorder::end_event(int id)
+    {
+        clock::time_point const end = clock::now();
+
+        pending_event event;
+        {
+            std::lock_guard<std::mutex> l(pending_mtx_);
+            auto it = pending_.find(id);
+            if (it == pending_.end())
+            {
+                return;
+            }
+            event = std::move(it->second);
+            pending_.erase(it);
+        }
+
+        add_span(std::move(event.name), event.category, event.begin, end);
+    }
+
+    // A pipeline run is the span between its begin_pipeline and
+    // end_pipeline events, the production of a Func (or of a part of it for
+    // Funcs computed inside of loops) the span between its produce and
+    // end_produce events. Halide passes the id returned for the begin event
+    // to the matching end event.
+    int trace_recorder::trace_hook(void*, halide_trace_event_t const* e)
+    {
+        trace_recorder& recorder = instance();
+        if (!recorder.enabled())
+        {
+            return 0;
+        }
+
+        switch (e->event)
+        {
+        case halide_trace_begin_pipeline:
+            return recorder.begin_event(e->func, "pipeline");
+
+        case halide_trace_produce:
+            return recorder.begin_event(e->func, "func");
+
+        case halide_trace_end_pipeline:
+            HPX_FALLTHROUGH;
+        case halide_trace_end_produce:
+            recorder.end_event(e->parent_id);
+            break;
+
+        default:
+            break;
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <HalideRuntime.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace phylanx_halide_common {
+
+    // Collects a timeline of the Halide pipelines and writes it as a Chrome
+    // trace (JSON, to be loaded into chrome://tracing or Perfetto) when HPX
+    // shuts down. Recording is enabled by naming the file:
+    //
+    //   phylanx.halide.trace.file = <path>
+    //
+    // The timeline holds one span per pipeline run and per production of
+    // each of its Funcs (from the Halide trace events, the pipelines have to
+    // be built with PHYLANX_HALIDE_WITH_TRACING) as well as one span per
+    // iteration of their parallel loops, on the HPX worker running it.
+    class trace_recorder
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        static trace_recorder& instance();
+
+        bool enabled() const
+        {
+            return !file_.empty();
+        }
+
+        void add_span(std::string name, char const* category,
+            clock::time_point begin, clock::time_point end);
+
+        void write() const;
+
+        // the hook to be passed to halide_set_custom_trace
+        static int trace_hook(void* ctx, halide_trace_event_t const* e);
+
+    private:
+        trace_recorder();
+
+        struct span
+        {
+            std::string name;
+            char const* category;
+            std::int64_t begin;    // [ns] since the recorder was created
+            std::int64_t end;
+        };
+
+        // one list per HPX worker, the last one collects the spans of all
+        // other threads
+        struct alignas(64) span_list
+        {
+            mutable std::mutex mtx;
+            std::vector<span> spans;
+        };
+
+        // the begin events waiting for their end event
+        struct pending_event
+        {
+            std::string name;
+            char const* category;
+            clock::time_point begin;
+        };
+
+        int begin_event(std::string name, char const* category);
+        void end_event(int id);
+
+        std::string const file_;
+        clock::time_point const start_;
+        std::vector<std::unique_ptr<span_list>> lists_;
+
+        std::mutex pending_mtx_;
+        int next_id_;
+        std::unordered_map<int, pending_event> pending_;
+    };
+}
@@ -11,4 +11,8 @@
 PHYLANX_REGISTER_PLUGIN_MODULE();
 
 PHYLANX_REGISTER_PLUGIN_FACTORY(harris_plugin,
-    phylanx_halide_plugin::harris::match_data);
+    phylanx_halide_plugin::harris::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(harris_batch_plugin,
+    phylanx_halide_plugin::harris::match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(harris_corners_plugin,
+    phylanx_halide_plugin::harris::match_data[2]);
@@ -7,19 +7,79 @@
 
 #include <Halide.h>
 
+#include "buffer_pool.hpp"
+#include "counters.hpp"
 #include "harris.h"
 #include "harris.hpp"
+#include "launch_policy.hpp"
+#include "pipeline.hpp"
+#include "result_pool.hpp"
+#include "harris_auto_schedule.h"
+#include "harris_batch.h"
+#include "harris_constant.h"
+#include "harris_constant_gray.h"
+#include "harris_constant_interleaved.h"
+#include "harris_corners_gray_3.h"
+#include "harris_corners_gray_5.h"
+#include "harris_corners_interleaved_3.h"
+#include "harris_corners_interleaved_5.h"
+#include "harris_corners_planar_3.h"
+#include "harris_corners_planar_5.h"
+#include "harris_gray.h"
+#include "harris_gray_auto_schedule.h"
+#include "harris_gray_s16.h"
+#include "harris_gray_s64.h"
+#include "harris_i64.h"
+#include "harris_i64_gray.h"
+#include "harris_i64_interleaved.h"
+#include "harris_interleaved.h"
+#include "harris_interleaved_auto_schedule.h"
+#include "harris_interleaved_s16.h"
+#include "harris_interleaved_s64.h"
+#include "harris_repeat_edge.h"
+#include "harris_repeat_edge_gray.h"
+#include "harris_repeat_edge_interleaved.h"
+#include "harris_s16.h"
+#include "harris_s64.h"
+#include "harris_u8.h"
+#include "harris_u8_gray.h"
+#include "harris_u8_interleaved.h"
+#include "harris_w5.h"
+#include "harris_w5_gray.h"
+#include "harris_w5_interleaved.h"
+#include "harris_w7.h"
+#include "harris_w7_gray.h"
+#include "harris_w7_interleaved.h"
+#include "shi_tomasi.h"
+#include "shi_tomasi_gray.h"
+#include "shi_tomasi_interleaved.h"
+#include "shi_tomasi_w5.h"
+#include "shi_tomasi_w5_gray.h"
+#include "shi_tomasi_w5_interleaved.h"
+#include "shi_tomasi_w7.h"
+#include "shi_tomasi_w7_gray.h"
+#include "shi_tomasi_w7_interleaved.h"
 
 #include <phylanx/config.hpp>
 
 #include <hpx/exception.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/include/util.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -27,64 +87,949 @@
 namespace phylanx_halide_plugin {
 
     constexpr char const* const help_string = R"(
-        harris(input)
+        harris(input, k, window, response, boundary)
         Args:
 
-            input (array) : image array to process
+            input (array) : image array to process, either a gray image
+                (2D), an image with up to four interleaved channels per
+                pixel (HWC) or a stack of color planes (CHW), boolean
+                (uint8) and integer images are filtered without being
+                converted to floating point first
 
         Returns:
 
-            the processed image
+            the processed image, shrunk by 3 pixels on each side (4 for
+            a window of 7)
+        )";
+
+    constexpr char const* const batch_help_string = R"(
+        harris_batch(frames)
+        Args:
+
+            frames (array) : 4D stack of (HWC) images to process, the first
+                dimension enumerates the frames
+
+        Returns:
+
+            the stacked responses of all frames
+        )";
+
+    constexpr char const* const corners_help_string = R"(
+        harris_corners(input, threshold, max_corners, nms_size)
+        Args:
+
+            input (array) : image array to process (see harris)
+            threshold (float) : minimal (positive) response of a corner
+            max_corners (optional, int) : if non-zero, return at most
+                this many of the strongest corners
+            nms_size (optional, int) : size of the neighborhood used for
+                non-maximum suppression, either 3 (default) or 5
+
+        Returns:
+
+            an (N, 3) array of the detected corners, each row holds the
+            x and y coordinate and the response of a corner, strongest
+            corners first
         )";
 
     ///////////////////////////////////////////////////////////////////////////
-    phylanx::execution_tree::match_pattern_type const harris::match_data = {
-        hpx::make_tuple("harris",
-            std::vector<std::string>{"harris(_1)"},
-            &create_harris,
-            &phylanx::execution_tree::create_primitive<harris>,
-            help_string)};
+    std::vector<phylanx::execution_tree::match_pattern_type> const
+        harris::match_data = {
+            phylanx::execution_tree::match_pattern_type{"harris",
+                std::vector<std::string>{
+                    "harris(_1, __arg(_2_k, 0.04), __arg(_3_window, 3), "
+                    "__arg(_4_response, \"harris\"), "
+                    "__arg(_5_boundary, \"none\"))"},
+                &create_harris,
+                &phylanx::execution_tree::create_primitive<harris>,
+                help_string},
+
+            phylanx::execution_tree::match_pattern_type{"harris_batch",
+                std::vector<std::string>{"harris_batch(_1)"},
+                &create_harris_batch,
+                &phylanx::execution_tree::create_primitive<harris>,
+                batch_help_string},
+
+            phylanx::execution_tree::match_pattern_type{"harris_corners",
+                std::vector<std::string>{
+                    "harris_corners(_1, _2, __arg(_3_max_corners, 0), "
+                    "__arg(_4_nms_size, 3))"},
+                &create_harris_corners,
+                &phylanx::execution_tree::create_primitive<harris>,
+                corners_help_string}};
+
+    harris::harris_mode extract_harris_mode(std::string const& name)
+    {
+        if (name.find("harris_batch") != std::string::npos)
+        {
+            return harris::HARRIS_BATCH;
+        }
+        if (name.find("harris_corners") != std::string::npos)
+        {
+            return harris::HARRIS_CORNERS;
+        }
+        return harris::HARRIS;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace {
+
+        // number of pixels the Harris stencils consume on each side of the
+        // image (the output is shrunk by this amount)
+        constexpr int halo = 3;
+
+        // the batch pipeline splits the output rows of a frame into strips of
+        // this many rows and vectorizes the columns by up to this many lanes
+        // (AVX-512), smaller frames are rejected by the pipeline
+        constexpr int batch_min_rows = 32;
+        constexpr int batch_min_columns = 8;
+
+        // the border grows with the summation window
+        int response_halo(harris::response_params const& response)
+        {
+            return (std::max)(halo, 1 + int(response.window / 2));
+        }
+
+        // Estimated FLOPs per output pixel: the gray conversion, the two
+        // Sobel filters, the products of the gradients, their window sums
+        // and the response (reported by the kernel counters).
+        double flops_per_pixel(
+            harris::response_params const& response, int channels)
+        {
+            double const gray = channels == 1 ? 0.0 : 5.0;
+            double const sums = 3.0 * (response.window * response.window - 1);
+            double const score = response.shi_tomasi ? 8.0 : 5.0;
+            return gray + 2 * 11.0 + 3.0 + sums + score;
+        }
+
+        // all pipelines take the image, k and the response
+        using harris_kernel_type =
+            int (*)(halide_buffer_t*, double, halide_buffer_t*);
+
+        enum class image_layout
+        {
+            planar,         // one plane per color channel (CHW)
+            interleaved,    // the channels of a pixel are adjacent (HWC)
+            gray            // single channel image
+        };
+
+        // select the pipeline instantiation matching the pixel type and the
+        // memory layout, the narrow types avoid widening the image to double
+        // before filtering
+        harris_kernel_type harris_kernel(double const*, image_layout layout)
+        {
+            switch (layout)
+            {
+            case image_layout::interleaved:
+                return &::harris_interleaved;
+            case image_layout::gray:
+                return &::harris_gray;
+            default:
+                break;
+            }
+            return &::harris;
+        }
+
+        harris_kernel_type harris_kernel(
+            std::int64_t const*, image_layout layout)
+        {
+            switch (layout)
+            {
+            case image_layout::interleaved:
+                return &::harris_i64_interleaved;
+            case image_layout::gray:
+                return &::harris_i64_gray;
+            default:
+                break;
+            }
+            return &::harris_i64;
+        }
+
+        harris_kernel_type harris_kernel(
+            std::uint8_t const*, image_layout layout)
+        {
+            switch (layout)
+            {
+            case image_layout::interleaved:
+                return &::harris_u8_interleaved;
+            case image_layout::gray:
+                return &::harris_u8_gray;
+            default:
+                break;
+            }
+            return &::harris_u8;
+        }
+
+        // An image described by its actual strides together with the
+        // pipeline specialized for that layout.
+        template <typename T>
+        struct harris_image
+        {
+            Halide::Runtime::Buffer<T> buffer;
+            harris_kernel_type kernel = nullptr;
+            image_layout layout = image_layout::planar;
+        };
+
+        template <typename T>
+        harris_image<T> make_harris_image(T* data, image_layout layout,
+            int width, int x_stride, int height, int y_stride, int channels,
+            int c_stride)
+        {
+            if (channels == 1)
+            {
+                layout = image_layout::gray;
+            }
+
+            halide_dimension_t shape[] = {{0, width, x_stride},
+                {0, height, y_stride}, {0, channels, c_stride}};
+
+            return harris_image<T>{Halide::Runtime::Buffer<T>(data, 3, shape),
+                harris_kernel(static_cast<T const*>(nullptr), layout), layout};
+        }
+
+        // Images are matrices (gray), tensors with up to four channels per
+        // pixel (HWC, interleaved) or tensors holding up to four color
+        // planes (CHW, planar).
+        template <typename T>
+        harris_image<T> make_harris_image(phylanx::ir::node_data<T>& data)
+        {
+            if (data.num_dimensions() == 2)
+            {
+                auto m = data.matrix();
+                return make_harris_image(m.data(), image_layout::gray,
+                    int(m.columns()), 1, int(m.rows()), int(m.spacing()), 1,
+                    1);
+            }
+
+            auto t = data.tensor();
+            if (t.columns() <= 4)
+            {
+                return make_harris_image(t.data(), image_layout::interleaved,
+                    int(t.rows()), int(t.spacing()), int(t.pages()),
+                    int(t.rows() * t.spacing()), int(t.columns()), 1);
+            }
+            return make_harris_image(t.data(), image_layout::planar,
+                int(t.columns()), 1, int(t.rows()), int(t.spacing()),
+                int(t.pages()), int(t.rows() * t.spacing()));
+        }
+
+        // The larger windows and the Shi-Tomasi response are instantiated
+        // for double images only.
+        harris_kernel_type harris_response_kernel(
+            image_layout layout, harris::response_params const& response)
+        {
+            // indexed by the layout and the window size (3, 5, 7)
+            static harris_kernel_type const harris_kernels[3][3] = {
+                {&::harris, &::harris_w5, &::harris_w7},
+                {&::harris_interleaved, &::harris_w5_interleaved,
+                    &::harris_w7_interleaved},
+                {&::harris_gray, &::harris_w5_gray, &::harris_w7_gray}};
+            static harris_kernel_type const shi_tomasi_kernels[3][3] = {
+                {&::shi_tomasi, &::shi_tomasi_w5, &::shi_tomasi_w7},
+                {&::shi_tomasi_interleaved, &::shi_tomasi_w5_interleaved,
+                    &::shi_tomasi_w7_interleaved},
+                {&::shi_tomasi_gray, &::shi_tomasi_w5_gray,
+                    &::shi_tomasi_w7_gray}};
+
+            auto const& kernels =
+                response.shi_tomasi ? shi_tomasi_kernels : harris_kernels;
+            return kernels[int(layout)][(response.window - 3) / 2];
+        }
+
+        // the pipelines compiled for the narrow pixel types as well
+        bool is_default_response(harris::response_params const& response)
+        {
+            return response.window == 3 && !response.shi_tomasi;
+        }
+
+        bool has_narrow_pipelines(harris::response_params const& response)
+        {
+            return is_default_response(response) &&
+                response.boundary == harris::BOUNDARY_NONE;
+        }
+
+        // The boundary conditions are instantiated for double images and
+        // the default response only.
+        harris_kernel_type harris_boundary_kernel(
+            image_layout layout, harris::boundary_mode boundary)
+        {
+            // indexed by the layout
+            static harris_kernel_type const repeat_edge_kernels[3] = {
+                &::harris_repeat_edge, &::harris_repeat_edge_interleaved,
+                &::harris_repeat_edge_gray};
+            static harris_kernel_type const constant_kernels[3] = {
+                &::harris_constant, &::harris_constant_interleaved,
+                &::harris_constant_gray};
+
+            return boundary == harris::BOUNDARY_CONSTANT ?
+                constant_kernels[int(layout)] :
+                repeat_edge_kernels[int(layout)];
+        }
+
+        // Fill the bands of 'border' pixels along the edges of a same size
+        // output, the interior is computed by the unbounded pipelines. Returns
+        // the result of the first failing pipeline call (or zero).
+        template <typename T>
+        int fill_border(harris_kernel_type kernel,
+            Halide::Runtime::Buffer<T>& input, double k, int border,
+            Halide::Runtime::Buffer<double>& output)
+        {
+            int const width = output.width();
+            int const height = output.height();
+
+            // the top and bottom bands span the full width, the left and
+            // right bands the rows in between
+            Halide::Runtime::Buffer<double> bands[] = {
+                output.cropped(1, 0, border),
+                output.cropped(1, height - border, border),
+                output.cropped(0, 0, border)
+                    .cropped(1, border, height - 2 * border),
+                output.cropped(0, width - border, border)
+                    .cropped(1, border, height - 2 * border)};
+
+            for (auto& band : bands)
+            {
+                int const result = kernel(input, k, band);
+                if (result != 0)
+                {
+                    return result;
+                }
+                band.device_sync();
+            }
+            return 0;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // A pipeline instantiation taking part in the on-host tuning.
+        struct harris_variant
+        {
+            harris_kernel_type kernel;
+            int min_height;    // rows required by the split of the schedule
+        };
+
+        std::vector<harris_variant> const& harris_variants(image_layout layout)
+        {
+            static std::vector<harris_variant> const planar = {
+                {&::harris, 32}, {&::harris_s16, 16}, {&::harris_s64, 64},
+                {&::harris_auto_schedule, 1}};
+            static std::vector<harris_variant> const interleaved = {
+                {&::harris_interleaved, 32}, {&::harris_interleaved_s16, 16},
+                {&::harris_interleaved_s64, 64},
+                {&::harris_interleaved_auto_schedule, 1}};
+            static std::vector<harris_variant> const gray = {
+                {&::harris_gray, 32}, {&::harris_gray_s16, 16},
+                {&::harris_gray_s64, 64}, {&::harris_gray_auto_schedule, 1}};
+
+            switch (layout)
+            {
+            case image_layout::interleaved:
+                return interleaved;
+            case image_layout::gray:
+                return gray;
+            default:
+                break;
+            }
+            return planar;
+        }
+
+        // The hand schedule was tuned for a particular machine. On the first
+        // call for a given shape bucket (and thread count) all variants are
+        // timed on the actual image and the fastest one is used afterwards.
+        // Tuning is disabled by setting 'phylanx.halide.harris.autotune=0'.
+        class harris_tuner
+        {
+            // layout, width and height bucket, channels, number of threads
+            using key_type = std::tuple<int, int, int, int, std::size_t>;
+
+            static int bucket(int value)
+            {
+                int b = 1;
+                while (b < value)
+                {
+                    b <<= 1;
+                }
+                return b;
+            }
+
+        public:
+            harris_tuner()
+              : enabled_(hpx::get_config_entry(
+                             "phylanx.halide.harris.autotune", "1") != "0")
+            {
+            }
+
+            int run(image_layout layout,
+                Halide::Runtime::Buffer<double>& input, double k,
+                Halide::Runtime::Buffer<double>& output)
+            {
+                auto const& variants = harris_variants(layout);
+                if (!enabled_)
+                {
+                    return variants.front().kernel(input, k, output);
+                }
+
+                key_type key(int(layout), bucket(input.width()),
+                    bucket(input.height()), input.channels(),
+                    hpx::get_os_thread_count());
+
+                harris_kernel_type winner = nullptr;
+                {
+                    std::lock_guard<std::mutex> l(mtx_);
+                    auto it = winners_.find(key);
+                    if (it != winners_.end())
+                    {
+                        winner = it->second;
+                    }
+                }
+
+                if (winner != nullptr)
+                {
+                    return winner(input, k, output);
+                }
+
+                // every timed run produces a valid result as well
+                harris_kernel_type best = variants.front().kernel;
+                harris_kernel_type last = nullptr;
+                double best_time = (std::numeric_limits<double>::max)();
+                for (auto const& variant : variants)
+                {
+                    if (output.height() < variant.min_height)
+                    {
+                        continue;
+                    }
+
+                    // the warm-up run takes the page faults and runtime
+                    // initialization, which would otherwise be charged to
+                    // whichever variant runs first
+                    if (variant.kernel(input, k, output) != 0)
+                    {
+                        continue;
+                    }
+                    output.device_sync();
+
+                    std::array<double, tuning_runs> times;
+                    bool failed = false;
+                    for (double& time : times)
+                    {
+                        auto start = std::chrono::steady_clock::now();
+                        if (variant.kernel(input, k, output) != 0)
+                        {
+                            failed = true;
+                            break;
+                        }
+                        output.device_sync();
+                        std::chrono::duration<double> elapsed =
+                            std::chrono::steady_clock::now() - start;
+                        time = elapsed.count();
+                    }
+                    if (failed)
+                    {
+                        continue;
+                    }
+
+                    // the median is robust against single disturbed runs
+                    std::nth_element(times.begin(),
+                        times.begin() + tuning_runs / 2, times.end());
+                    double const median = times[tuning_runs / 2];
+
+                    last = variant.kernel;
+                    if (median < best_time)
+                    {
+                        best_time = median;
+                        best = variant.kernel;
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> l(mtx_);
+                    winners_.emplace(key, best);
+                }
+
+                // the output has to be produced by a successful run
+                if (last == nullptr)
+                {
+                    return best(input, k, output);
+                }
+                return 0;
+            }
+
+        private:
+            // timed runs per variant, following an untimed warm-up run
+            static constexpr std::size_t tuning_runs = 5;
+
+            bool const enabled_;
+            std::mutex mtx_;
+            std::map<key_type, harris_kernel_type> winners_;
+        };
+
+        // only the double pipelines of the default response are tuned
+        template <typename T>
+        int run_harris(harris_image<T>& img, double k,
+            Halide::Runtime::Buffer<double>& output)
+        {
+            return img.kernel(img.buffer, k, output);
+        }
+
+        int run_harris(harris_image<double>& img, double k,
+            Halide::Runtime::Buffer<double>& output)
+        {
+            static harris_tuner tuner;
+            return tuner.run(img.layout, img.buffer, k, output);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        using harris_corners_kernel_type =
+            int (*)(halide_buffer_t*, double, halide_buffer_t*);
+
+        harris_corners_kernel_type harris_corners_kernel(
+            image_layout layout, int nms_size)
+        {
+            bool const wide = nms_size == 5;
+            switch (layout)
+            {
+            case image_layout::interleaved:
+                return wide ? &::harris_corners_interleaved_5 :
+                              &::harris_corners_interleaved_3;
+            case image_layout::gray:
+                return wide ? &::harris_corners_gray_5 :
+                              &::harris_corners_gray_3;
+            default:
+                break;
+            }
+            return wide ? &::harris_corners_planar_5 :
+                          &::harris_corners_planar_3;
+        }
+
+        // the corner pipelines split the rows by this factor
+        constexpr int corner_strip_rows = 32;
+
+        struct corner
+        {
+            double response;
+            int x;
+            int y;
+        };
+
+        // strongest corners first, ties are broken by the position to make
+        // the result independent of the order the strips were processed in
+        bool stronger(corner const& lhs, corner const& rhs)
+        {
+            if (lhs.response != rhs.response)
+            {
+                return lhs.response > rhs.response;
+            }
+            return lhs.y < rhs.y || (lhs.y == rhs.y && lhs.x < rhs.x);
+        }
+
+        void keep_strongest(std::vector<corner>& corners, std::size_t count)
+        {
+            if (count != 0 && corners.size() > count)
+            {
+                std::nth_element(corners.begin(), corners.begin() + count,
+                    corners.end(), stronger);
+                corners.resize(count);
+            }
+        }
+    }
 
     ///////////////////////////////////////////////////////////////////////////
     harris::harris(primitive_arguments_type&& operands, std::string const& name,
         std::string const& codename)
       : phylanx::execution_tree::primitives::primitive_component_base(
             std::move(operands), name, codename)
+      , mode_(extract_harris_mode(name_))
+    {
+        for (auto const& pattern : match_data)
+        {
+            phylanx_halide_common::install_kernel_counters(
+                pattern.primitive_type_);
+        }
+        phylanx_halide_common::install_buffer_pool_counters();
+        phylanx_halide_common::install_result_pool_counters();
+    }
+
+    template <typename T>
+    phylanx::execution_tree::primitive_argument_type harris::filter(
+        phylanx::ir::node_data<T>&& data, response_params const& response,
+        eval_context ctx) const
     {
+        if (data.num_dimensions() != 2 && data.num_dimensions() != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::filter",
+                generate_error_message("the harris filter primitive accepts "
+                                       "only 2D or 3D data as it's input",
+                    ctx));
+        }
+
+        auto img = make_harris_image(data);
+        auto& input = img.buffer;
+
+        if (input.channels() != 1 && input.channels() < 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::filter",
+                generate_error_message("the harris filter primitive requires "
+                                       "a gray or a color (RGB) image",
+                    ctx));
+        }
+
+        int const border = response_halo(response);
+        if (input.width() <= 2 * border || input.height() <= 2 * border)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::filter",
+                generate_error_message("the harris filter primitive requires "
+                                       "an image larger than twice the "
+                                       "border of the response",
+                    ctx));
+        }
+
+        // the dispatcher converts the image to double for any response
+        // lacking a narrow instantiation
+        HPX_ASSERT(
+            has_narrow_pipelines(response) || std::is_same<T, double>::value);
+        bool const tuned = is_default_response(response);
+        harris_kernel_type kernel =
+            tuned ? img.kernel : harris_response_kernel(img.layout, response);
+
+        // a boundary condition keeps the size of the image
+        bool const same_size = response.boundary != BOUNDARY_NONE;
+        int const shrink = same_size ? 0 : 2 * border;
+
+        double const pixels = double(input.height() - shrink) *
+            double(input.width() - shrink);
+
+        phylanx_halide_common::pipeline_scope scope("harris");
+        phylanx_halide_common::kernel_timer timer("harris",
+            pixels * flops_per_pixel(response, input.channels()),
+            double(input.size_in_bytes()) + 8.0 * pixels);
+
+        // the response has one row per image row
+        auto& results = phylanx_halide_common::result_pool::instance();
+        blaze::DynamicMatrix<double> outimg = results.matrix(
+            input.height() - shrink, input.width() - shrink);
+
+        {
+            int const origin = same_size ? 0 : border;
+            halide_dimension_t shape[] = {
+                {origin, int(outimg.columns()), 1},
+                {origin, int(outimg.rows()), int(outimg.spacing())}};
+            Halide::Runtime::Buffer<double> image_output(
+                outimg.data(), 2, shape);
+
+            // the unbounded pipelines compute the interior only
+            Halide::Runtime::Buffer<double> output = image_output.cropped(
+                {{border, input.width() - 2 * border},
+                    {border, input.height() - 2 * border}});
+
+            int result = 0;
+            if (same_size)
+            {
+                result = fill_border(
+                    harris_boundary_kernel(img.layout, response.boundary),
+                    input, response.k, border, image_output);
+            }
+
+            if (result == 0)
+            {
+                result = tuned ? run_harris(img, response.k, output) :
+                                 kernel(input, response.k, output);
+            }
+
+            // the schedules split the rows into strips and vectorize the
+            // columns, images smaller than that are rejected by the pipeline
+            if (result != 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "harris::filter",
+                    generate_error_message("the harris pipeline rejected the "
+                                           "image, it may be too small for "
+                                           "the schedule of the pipeline",
+                        ctx));
+            }
+            output.device_sync();
+        }
+
+        // the image is not needed anymore, its storage serves a later result
+        results.release(std::move(data));
+
+        return primitive_argument_type(std::move(outimg));
     }
 
     phylanx::execution_tree::primitive_argument_type harris::filter(
+        primitive_argument_type&& val, response_params const& response,
+        eval_context ctx) const
+    {
+        using namespace phylanx::execution_tree;
+
+        if (response.window != 3 && response.window != 5 &&
+            response.window != 7)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::filter",
+                generate_error_message("the harris filter primitive supports "
+                                       "a window of 3, 5 or 7 only",
+                    ctx));
+        }
+
+        if (response.boundary != BOUNDARY_NONE &&
+            !is_default_response(response))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::filter",
+                generate_error_message("the harris filter primitive supports "
+                                       "boundary conditions for the 3x3 "
+                                       "Harris response only",
+                    ctx));
+        }
+
+        // only the default response is instantiated for the narrow types
+        auto const type = has_narrow_pipelines(response) ?
+            extract_common_type(val) :
+            node_data_type_double;
+
+        switch (type)
+        {
+        case node_data_type_bool:
+            return filter(extract_boolean_value_strict(
+                              std::move(val), name_, codename_),
+                response, std::move(ctx));
+
+        case node_data_type_int64:
+            return filter(extract_integer_value_strict(
+                              std::move(val), name_, codename_),
+                response, std::move(ctx));
+
+        case node_data_type_unknown:
+            HPX_FALLTHROUGH;
+        case node_data_type_double:
+            return filter(
+                extract_numeric_value(std::move(val), name_, codename_),
+                response, std::move(ctx));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "harris::filter",
+            generate_error_message("the harris filter primitive requires "
+                                   "an image of numeric values",
+                ctx));
+    }
+
+    phylanx::execution_tree::primitive_argument_type harris::filter_batch(
         primitive_argument_type&& val, eval_context ctx) const
     {
         auto data = extract_numeric_value(std::move(val), name_, codename_);
 
+#if defined(PHYLANX_MAX_DIMENSIONS) && PHYLANX_MAX_DIMENSIONS >= 4
         if (phylanx::execution_tree::extract_numeric_value_dimension(
-                data, name_, codename_) != 3)
+                data, name_, codename_) != 4)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "harris::filter",
-                generate_error_message("the harris filter primitive accepts "
-                                       "only 3D data as it's input",
+                "harris::filter_batch",
+                generate_error_message("the harris_batch primitive accepts "
+                                       "only 4D data as it's input",
+                    ctx));
+        }
+
+        // frames are stacks of interleaved (HWC) images
+        auto frames = data.quatern();
+        halide_dimension_t in_shape[] = {
+            {0, int(frames.rows()), int(frames.spacing())},
+            {0, int(frames.pages()), int(frames.rows() * frames.spacing())},
+            {0, int(frames.columns()), 1},
+            {0, int(frames.quats()),
+                int(frames.pages() * frames.rows() * frames.spacing())}};
+        Halide::Runtime::Buffer<double> input(frames.data(), 4, in_shape);
+
+        if (input.width() < batch_min_columns + 2 * halo ||
+            input.height() < batch_min_rows + 2 * halo)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::filter_batch",
+                generate_error_message("the harris_batch primitive requires "
+                                       "frames of at least 38 rows and 14 "
+                                       "columns",
                     ctx));
         }
 
-        auto img = data.tensor();
-        Halide::Runtime::Buffer<double> input(
-            img.data(), img.rows(), img.pages(), img.columns());
+        if (input.channels() < 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::filter_batch",
+                generate_error_message("the harris_batch primitive requires "
+                                       "color (RGB) frames",
+                    ctx));
+        }
 
-        blaze::DynamicMatrix<double> outimg(
-            input.width() - 6, input.height() - 6);
+        // all responses are written into one pre-allocated tensor
+        blaze::DynamicTensor<double> outimgs =
+            phylanx_halide_common::result_pool::instance().tensor(
+                frames.quats(), input.height() - 2 * halo,
+                input.width() - 2 * halo);
 
         {
+            halide_dimension_t out_shape[] = {
+                {halo, int(outimgs.columns()), 1},
+                {halo, int(outimgs.rows()), int(outimgs.spacing())},
+                {0, int(outimgs.pages()),
+                    int(outimgs.rows() * outimgs.spacing())}};
             Halide::Runtime::Buffer<double> output(
-                outimg.data(), outimg.rows(), outimg.columns());
-            output.set_min(3, 3);
+                outimgs.data(), 3, out_shape);
 
-            ::harris(input, output);
+            phylanx_halide_common::pipeline_scope scope("harris_batch");
+            double const pixels = double(outimgs.pages()) *
+                double(outimgs.rows()) * double(outimgs.columns());
+            phylanx_halide_common::kernel_timer timer("harris_batch",
+                pixels * flops_per_pixel(response_params(), input.channels()),
+                double(input.size_in_bytes()) + 8.0 * pixels);
+            if (::harris_batch(input, output) != 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "harris::filter_batch",
+                    generate_error_message(
+                        "the harris_batch pipeline rejected the frames", ctx));
+            }
             output.device_sync();
         }
 
-        return primitive_argument_type(std::move(outimg));
+        return primitive_argument_type(std::move(outimgs));
+#else
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "harris::filter_batch",
+            generate_error_message("the harris_batch primitive requires "
+                                   "Phylanx to be configured with support "
+                                   "for 4D arrays",
+                ctx));
+#endif
+    }
+
+    phylanx::execution_tree::primitive_argument_type harris::corners(
+        primitive_argument_type&& val, double threshold,
+        std::int64_t max_corners, std::int64_t nms_size,
+        eval_context ctx) const
+    {
+        auto data = extract_numeric_value(std::move(val), name_, codename_);
+
+        if (data.num_dimensions() != 2 && data.num_dimensions() != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::corners",
+                generate_error_message("the harris_corners primitive accepts "
+                                       "only 2D or 3D data as it's input",
+                    ctx));
+        }
+
+        if (nms_size != 3 && nms_size != 5)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::corners",
+                generate_error_message("the harris_corners primitive "
+                                       "supports a nms_size of 3 or 5 only",
+                    ctx));
+        }
+
+        auto img = make_harris_image(data);
+        auto& input = img.buffer;
+
+        if (input.channels() != 1 && input.channels() < 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::corners",
+                generate_error_message("the harris_corners primitive "
+                                       "requires a gray or a color (RGB) "
+                                       "image",
+                    ctx));
+        }
+
+        int const border = halo + int(nms_size / 2);
+        int const width = input.width() - 2 * border;
+        int const height = input.height() - 2 * border;
+        if (width <= 0 || height < corner_strip_rows)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "harris::corners",
+                generate_error_message("the image is too small for the "
+                                       "harris_corners primitive",
+                    ctx));
+        }
+
+        auto kernel = harris_corners_kernel(img.layout, int(nms_size));
+
+        // Every strip runs the fused pipeline into a strip sized buffer and
+        // collects its own strongest corners, the full response is never
+        // materialized.
+        std::size_t const num_strips = height / corner_strip_rows;
+        std::vector<std::vector<corner>> strip_corners(num_strips);
+
+        // the non-maximum suppression compares every pixel to its window
+        double const pixels = double(width) * height;
+        phylanx_halide_common::kernel_timer timer("harris_corners",
+            pixels *
+                (flops_per_pixel(response_params(), input.channels()) +
+                    double(nms_size * nms_size)),
+            double(input.size_in_bytes()));
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), num_strips,
+            [&](std::size_t i) {
+                int const y0 = border + int(i) * corner_strip_rows;
+                int const h = (i + 1 == num_strips) ?
+                    border + height - y0 :
+                    corner_strip_rows;
+
+                using phylanx_halide_common::buffer_pool;
+
+                phylanx_halide_common::pipeline_scope scope("harris_corners");
+
+                Halide::Runtime::Buffer<double> response(
+                    nullptr, width, h);
+                response.allocate(&buffer_pool::halide_allocate,
+                    &buffer_pool::halide_deallocate);
+                response.set_min(border, y0);
+
+                if (kernel(input, threshold, response) != 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::invalid_status,
+                        "harris::corners",
+                        "the harris_corners pipeline reported an error");
+                }
+
+                auto& found = strip_corners[i];
+                for (int y = y0; y != y0 + h; ++y)
+                {
+                    for (int x = border; x != border + width; ++x)
+                    {
+                        double const r = response(x, y);
+                        if (r != 0.0)
+                        {
+                            found.push_back(corner{r, x, y});
+                        }
+                    }
+                }
+                keep_strongest(found, std::size_t(max_corners));
+            });
+
+        // merge the per-strip candidates
+        std::vector<corner> all_corners;
+        for (auto& found : strip_corners)
+        {
+            all_corners.insert(all_corners.end(), found.begin(), found.end());
+        }
+        keep_strongest(all_corners, std::size_t(max_corners));
+        std::sort(all_corners.begin(), all_corners.end(), stronger);
+
+        blaze::DynamicMatrix<double> result(all_corners.size(), 3);
+        for (std::size_t i = 0; i != all_corners.size(); ++i)
+        {
+            result(i, 0) = all_corners[i].x;
+            result(i, 1) = all_corners[i].y;
+            result(i, 2) = all_corners[i].response;
+        }
+
+        return primitive_argument_type(std::move(result));
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -92,24 +1037,152 @@ namespace phylanx_halide_plugin {
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 1)
+        using phylanx_halide_common::launch_kernel;
+        using phylanx_halide_common::operand_values;
+
+        // small images are filtered inline, large ones on a new HPX thread
+        static phylanx_halide_common::launch_policy const policy(
+            "harris", 16384);
+
+        auto this_ = this->shared_from_this();
+
+        if (mode_ == HARRIS_BATCH)
+        {
+            if (operands.size() != 1)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "harris::eval",
+                    generate_error_message(
+                        "harris_batch accepts exactly one argument", ctx));
+            }
+
+            return launch_kernel(policy,
+                [this_ = std::move(this_), ctx](
+                    primitive_arguments_type&& vals)
+                    -> primitive_argument_type {
+                    return this_->filter_batch(std::move(vals[0]), ctx);
+                },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (mode_ == HARRIS_CORNERS)
+        {
+            if (operands.size() < 2 || operands.size() > 4)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "harris::eval",
+                    generate_error_message(
+                        "harris_corners accepts between two and four "
+                        "arguments",
+                        ctx));
+            }
+
+            return launch_kernel(policy,
+                [this_ = std::move(this_), ctx](
+                    primitive_arguments_type&& vals)
+                    -> primitive_argument_type {
+                    using namespace phylanx::execution_tree;
+
+                    vals.resize(4);
+
+                    double threshold = extract_scalar_numeric_value(
+                        std::move(vals[1]), this_->name_, this_->codename_);
+
+                    std::int64_t max_corners = 0;
+                    if (valid(vals[2]))
+                    {
+                        max_corners = extract_scalar_integer_value(
+                            std::move(vals[2]), this_->name_,
+                            this_->codename_);
+                    }
+
+                    std::int64_t nms_size = 3;
+                    if (valid(vals[3]))
+                    {
+                        nms_size = extract_scalar_integer_value(
+                            std::move(vals[3]), this_->name_,
+                            this_->codename_);
+                    }
+
+                    return this_->corners(std::move(vals[0]), threshold,
+                        (std::max)(max_corners, std::int64_t(0)), nms_size,
+                        ctx);
+                },
+                operand_values(operands, args, name_, codename_, ctx));
+        }
+
+        if (operands.empty() || operands.size() > 5)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "harris::eval",
                 generate_error_message(
-                    "harris accepts exactly one argument", ctx));
+                    "harris accepts between one and five arguments", ctx));
         }
 
-        auto this_ = this->shared_from_this();
-        auto ctx_ = ctx;
-        return hpx::dataflow(
-            hpx::launch::sync,
-            [this_ = std::move(this_), ctx = std::move(ctx_)](
-                hpx::future<primitive_argument_type>&& val)
+        return launch_kernel(policy,
+            [this_ = std::move(this_), ctx](primitive_arguments_type&& vals)
                 -> primitive_argument_type {
-                return this_->filter(val.get(), ctx);
+                using namespace phylanx::execution_tree;
+
+                vals.resize(5);
+
+                response_params response;
+                if (valid(vals[1]))
+                {
+                    response.k = extract_scalar_numeric_value(
+                        std::move(vals[1]), this_->name_, this_->codename_);
+                }
+
+                if (valid(vals[2]))
+                {
+                    response.window = extract_scalar_integer_value(
+                        std::move(vals[2]), this_->name_, this_->codename_);
+                }
+
+                if (valid(vals[3]))
+                {
+                    std::string const name = extract_string_value(
+                        std::move(vals[3]), this_->name_, this_->codename_);
+                    if (name == "shi_tomasi")
+                    {
+                        response.shi_tomasi = true;
+                    }
+                    else if (name != "harris")
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "harris::eval",
+                            this_->generate_error_message(
+                                "the response has to be either 'harris' "
+                                "or 'shi_tomasi'",
+                                ctx));
+                    }
+                }
+
+                if (valid(vals[4]))
+                {
+                    std::string const name = extract_string_value(
+                        std::move(vals[4]), this_->name_, this_->codename_);
+                    if (name == "repeat_edge")
+                    {
+                        response.boundary = BOUNDARY_REPEAT_EDGE;
+                    }
+                    else if (name == "constant")
+                    {
+                        response.boundary = BOUNDARY_CONSTANT;
+                    }
+                    else if (name != "none")
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "harris::eval",
+                            this_->generate_error_message(
+                                "the boundary has to be one of 'none', "
+                                "'repeat_edge' or 'constant'",
+                                ctx));
+                    }
+                }
+
+                return this_->filter(std::move(vals[0]), response, ctx);
             },
-            phylanx::execution_tree::value_operand(
-                operands[0], args, name_, codename_, std::move(ctx)));
+            operand_values(operands, args, name_, codename_, ctx));
     }
 }
@@ -11,6 +11,7 @@
 
 #include <hpx/future.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -29,6 +30,25 @@ namespace phylanx_halide_plugin {
             phylanx::execution_tree::primitive_arguments_type;
         using eval_context = phylanx::execution_tree::eval_context;
 
+    public:
+        // Handling of the pixels along the edges of the image.
+        enum boundary_mode
+        {
+            BOUNDARY_NONE,          // the output shrinks by the border
+            BOUNDARY_REPEAT_EDGE,   // same size, edge pixels are replicated
+            BOUNDARY_CONSTANT       // same size, zero outside of the image
+        };
+
+        // Parameters of the corner response, the defaults select the
+        // original Harris filter.
+        struct response_params
+        {
+            double k = 0.04;
+            std::int64_t window = 3;
+            bool shi_tomasi = false;
+            boundary_mode boundary = BOUNDARY_NONE;
+        };
+
     protected:
         // hpx::future<primitive_argument_type> eval(
         //     primitive_arguments_type const& operands,
@@ -38,11 +58,32 @@ namespace phylanx_halide_plugin {
             primitive_arguments_type const& args,
             eval_context ctx) const override;
 
-        primitive_argument_type filter(
+        primitive_argument_type filter(primitive_argument_type&& val,
+            response_params const& response, eval_context ctx) const;
+
+        template <typename T>
+        primitive_argument_type filter(phylanx::ir::node_data<T>&& data,
+            response_params const& response, eval_context ctx) const;
+
+        // Apply the filter to all frames of a 4D stack of images at once.
+        primitive_argument_type filter_batch(
             primitive_argument_type&& val, eval_context ctx) const;
 
+        // Detect corners, i.e. thresholded local maxima of the response.
+        primitive_argument_type corners(primitive_argument_type&& val,
+            double threshold, std::int64_t max_corners, std::int64_t nms_size,
+            eval_context ctx) const;
+
     public:
-        static phylanx::execution_tree::match_pattern_type const match_data;
+        enum harris_mode
+        {
+            HARRIS,
+            HARRIS_BATCH,
+            HARRIS_CORNERS
+        };
+
+        static std::vector<phylanx::execution_tree::match_pattern_type> const
+            match_data;
 
         harris() = default;
 
@@ -53,6 +94,9 @@ namespace phylanx_halide_plugin {
         //     primitive_arguments_type const& params,
         //     primitive_arguments_type const& args,
         //     eval_context ctx) const override;
+
+    private:
+        harris_mode mode_;
     };
 
     inline phylanx::execution_tree::primitive create_harris(
@@ -63,4 +107,22 @@ namespace phylanx_halide_plugin {
         return phylanx::execution_tree::create_primitive_component(
             locality, "harris", std::move(operands), name, codename);
     }
+
+    inline phylanx::execution_tree::primitive create_harris_batch(
+        hpx::id_type const& locality,
+        phylanx::execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return phylanx::execution_tree::create_primitive_component(
+            locality, "harris_batch", std::move(operands), name, codename);
+    }
+
+    inline phylanx::execution_tree::primitive create_harris_corners(
+        hpx::id_type const& locality,
+        phylanx::execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return phylanx::execution_tree::create_primitive_component(
+            locality, "harris_corners", std::move(operands), name, codename);
+    }
 }
@@ -1,93 +1,329 @@
 #include "Halide.h"
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
 namespace {
 
 using namespace Halide;
 
-Expr sum3x3(Func f, Var x, Var y) {
-    return f(x - 1, y - 1) + f(x - 1, y) + f(x - 1, y + 1) +
-           f(x, y - 1) + f(x, y) + f(x, y + 1) +
-           f(x + 1, y - 1) + f(x + 1, y) + f(x + 1, y + 1);
+// Memory layout of the color channels of the input image.
+enum class Layout {
+    Planar,       // one plane per channel, x has a stride of one
+    Interleaved,  // channels of a pixel are adjacent, c has a stride of one
+    Gray,         // a single channel, x has an arbitrary stride
+};
+
+const std::map<std::string, Layout> layout_names = {
+    {"planar", Layout::Planar},
+    {"interleaved", Layout::Interleaved},
+    {"gray", Layout::Gray},
+};
+
+// Handling of the pixels outside of the input image.
+enum class Boundary {
+    None,        // the output shrinks by the border of the response
+    RepeatEdge,  // replicate the pixels along the edges of the image
+    Constant,    // pixels outside of the image are zero
+};
+
+const std::map<std::string, Boundary> boundary_names = {
+    {"none", Boundary::None},
+    {"repeat_edge", Boundary::RepeatEdge},
+    {"constant", Boundary::Constant},
+};
+
+// Relax/require the strides of the input as demanded by its layout.
+template<class In>
+void constrain_layout(In &input, Layout layout) {
+    switch (layout) {
+    case Layout::Interleaved:
+        input.dim(0).set_stride(Expr());
+        input.dim(2).set_stride(1);
+        break;
+    case Layout::Gray:
+        input.dim(0).set_stride(Expr());
+        input.dim(2).set_bounds(0, 1);
+        break;
+    default:
+        break;
+    }
 }
 
-class Harris : public Halide::Generator<Harris> {
-public:
-    Input<Buffer<double>> input{"input", 3};
-    Output<Buffer<double>> output{"output", 2};
+// Emit specializations for the pixel strides we commonly see, this allows
+// for dense (shuffled) vector loads instead of gathers.
+template<class In>
+void specialize_layout(Func output, In &input, Layout layout) {
+    switch (layout) {
+    case Layout::Interleaved:
+        output.specialize(input.dim(0).stride() == 3);  // RGB
+        output.specialize(input.dim(0).stride() == 4);  // RGBA, padded RGB
+        break;
+    case Layout::Gray:
+        output.specialize(input.dim(0).stride() == 1);
+        break;
+    default:
+        break;
+    }
+}
 
-    void generate() {
-        Var x("x"), y("y"), c("c");
+// The corner measure computed from the structure tensor.
+enum class ResponseMode {
+    Harris,     // det - k * trace^2
+    ShiTomasi,  // the smaller eigenvalue
+};
 
-        // Algorithm
-        Func gray("gray");
-        gray(x, y) = (0.299f * input(x, y, 0) +
-                      0.587f * input(x, y, 1) +
-                      0.114f * input(x, y, 2));
+const std::map<std::string, ResponseMode> response_names = {
+    {"harris", ResponseMode::Harris},
+    {"shi_tomasi", ResponseMode::ShiTomasi},
+};
 
-        Func Iy("Iy");
-        Iy(x, y) = gray(x - 1, y - 1) * (-1.0f / 12) + gray(x - 1, y + 1) * (1.0f / 12) +
-                   gray(x, y - 1) * (-2.0f / 12) + gray(x, y + 1) * (2.0f / 12) +
-                   gray(x + 1, y - 1) * (-1.0f / 12) + gray(x + 1, y + 1) * (1.0f / 12);
+// Parameters of the corner response, the defaults are those of the original
+// Harris filter.
+struct ResponseParams {
+    Expr k = 0.04f;     // sensitivity (Harris only)
+    int window = 3;     // size of the (odd) summation window
+    ResponseMode mode = ResponseMode::Harris;
+};
 
-        Func Ix("Ix");
-        Ix(x, y) = gray(x - 1, y - 1) * (-1.0f / 12) + gray(x + 1, y - 1) * (1.0f / 12) +
-                   gray(x - 1, y) * (-2.0f / 12) + gray(x + 1, y) * (2.0f / 12) +
-                   gray(x - 1, y + 1) * (-1.0f / 12) + gray(x + 1, y + 1) * (1.0f / 12);
+// Number of pixels the response consumes on each side of the image: one for
+// the gradients and window / 2 for the summation. Small windows keep the
+// original border of three pixels.
+int response_halo(int window) {
+    return std::max(3, 1 + window / 2);
+}
 
-        Func Ixx("Ixx");
-        Ixx(x, y) = Ix(x, y) * Ix(x, y);
+// The stages of the Harris corner response, kept around for scheduling.
+// 'row_sums' holds the horizontal pass of separable window sums (if any).
+struct HarrisStages {
+    Func gray{"gray"};
+    Func Ix{"Ix"};
+    Func Iy{"Iy"};
+    Func response{"response"};
+    std::vector<Func> row_sums;
+};
 
-        Func Iyy("Iyy");
-        Iyy(x, y) = Iy(x, y) * Iy(x, y);
+// Define the Harris corner response of a color image. The pixel (x, y, c) of
+// the image is read through 'input', 'rest' holds the pure variables of any
+// dimensions following x and y (e.g. the frame of a batch). Gray images are
+// used as is, 'gray' then is a trivial wrapper that should be inlined.
+HarrisStages define_harris(const std::function<Expr(Expr, Expr, Expr)> &input,
+                           Var x, Var y, Layout layout,
+                           const std::vector<Var> &rest = {},
+                           const ResponseParams &params = ResponseParams()) {
+    const auto at = [&](Expr xe, Expr ye) {
+        std::vector<Expr> args{xe, ye};
+        args.insert(args.end(), rest.begin(), rest.end());
+        return args;
+    };
 
-        Func Ixy("Ixy");
-        Ixy(x, y) = Ix(x, y) * Iy(x, y);
+    HarrisStages s;
+    Func &gray = s.gray;
+    Func &Ix = s.Ix;
+    Func &Iy = s.Iy;
 
-        Func Sxx("Sxx");
-        Sxx(x, y) = sum3x3(Ixx, x, y);
+    // The 3x3 window is summed directly, larger windows are summed
+    // separably (rows first) to keep the cost linear in the window size.
+    const int radius = params.window / 2;
+    const auto window_sum = [&](Func f) {
+        if (radius == 1) {
+            return f(at(x - 1, y - 1)) + f(at(x - 1, y)) + f(at(x - 1, y + 1)) +
+                   f(at(x, y - 1)) + f(at(x, y)) + f(at(x, y + 1)) +
+                   f(at(x + 1, y - 1)) + f(at(x + 1, y)) + f(at(x + 1, y + 1));
+        }
+
+        Func row(f.name() + "_row");
+        Expr row_sum = f(at(x - radius, y));
+        for (int i = -radius + 1; i <= radius; ++i) {
+            row_sum += f(at(x + i, y));
+        }
+        row(at(x, y)) = row_sum;
+        s.row_sums.push_back(row);
 
-        Func Syy("Syy");
-        Syy(x, y) = sum3x3(Iyy, x, y);
+        Expr sum = row(at(x, y - radius));
+        for (int i = -radius + 1; i <= radius; ++i) {
+            sum += row(at(x, y + i));
+        }
+        return sum;
+    };
+
+    // Algorithm
+    if (layout == Layout::Gray) {
+        gray(at(x, y)) = input(x, y, 0);
+    } else {
+        gray(at(x, y)) = (0.299f * input(x, y, 0) +
+                          0.587f * input(x, y, 1) +
+                          0.114f * input(x, y, 2));
+    }
 
-        Func Sxy("Sxy");
-        Sxy(x, y) = sum3x3(Ixy, x, y);
+    Iy(at(x, y)) = gray(at(x - 1, y - 1)) * (-1.0f / 12) + gray(at(x - 1, y + 1)) * (1.0f / 12) +
+                   gray(at(x, y - 1)) * (-2.0f / 12) + gray(at(x, y + 1)) * (2.0f / 12) +
+                   gray(at(x + 1, y - 1)) * (-1.0f / 12) + gray(at(x + 1, y + 1)) * (1.0f / 12);
 
+    Ix(at(x, y)) = gray(at(x - 1, y - 1)) * (-1.0f / 12) + gray(at(x + 1, y - 1)) * (1.0f / 12) +
+                   gray(at(x - 1, y)) * (-2.0f / 12) + gray(at(x + 1, y)) * (2.0f / 12) +
+                   gray(at(x - 1, y + 1)) * (-1.0f / 12) + gray(at(x + 1, y + 1)) * (1.0f / 12);
+
+    Func Ixx("Ixx");
+    Ixx(at(x, y)) = Ix(at(x, y)) * Ix(at(x, y));
+
+    Func Iyy("Iyy");
+    Iyy(at(x, y)) = Iy(at(x, y)) * Iy(at(x, y));
+
+    Func Ixy("Ixy");
+    Ixy(at(x, y)) = Ix(at(x, y)) * Iy(at(x, y));
+
+    Func Sxx("Sxx");
+    Sxx(at(x, y)) = window_sum(Ixx);
+
+    Func Syy("Syy");
+    Syy(at(x, y)) = window_sum(Iyy);
+
+    Func Sxy("Sxy");
+    Sxy(at(x, y)) = window_sum(Ixy);
+
+    Func trace("trace");
+    trace(at(x, y)) = Sxx(at(x, y)) + Syy(at(x, y));
+
+    if (params.mode == ResponseMode::ShiTomasi) {
+        // min(l1, l2) = (trace - sqrt((Sxx - Syy)^2 + 4 Sxy^2)) / 2
+        Expr diff = Sxx(at(x, y)) - Syy(at(x, y));
+        Expr disc = diff * diff + 4.0f * Sxy(at(x, y)) * Sxy(at(x, y));
+        s.response(at(x, y)) = 0.5f * (trace(at(x, y)) - sqrt(disc));
+    } else {
         Func det("det");
-        det(x, y) = Sxx(x, y) * Syy(x, y) - Sxy(x, y) * Sxy(x, y);
+        det(at(x, y)) = Sxx(at(x, y)) * Syy(at(x, y)) - Sxy(at(x, y)) * Sxy(at(x, y));
+
+        Expr t = trace(at(x, y));
+        s.response(at(x, y)) = det(at(x, y)) - cast(t.type(), params.k) * t * t;
+    }
+
+    return s;
+}
+
+// Harris corner response of a single image. The pixels are read as TIn, all
+// arithmetic is performed in TMath and the response is stored as TOut. The
+// window size and the response mode are compiled in, k is a runtime input.
+// With a boundary condition the pipeline is meant to fill only the thin
+// bands along the edges of a same size output (the interior is left to the
+// unbounded pipeline) and is scheduled accordingly.
+template<class TIn, class TMath, class TOut>
+class Harris : public Halide::Generator<Harris<TIn, TMath, TOut>> {
+public:
+    typedef Halide::Generator<Harris<TIn, TMath, TOut>> Base;
+    using Base::auto_schedule;
+    using Base::get_target;
+    using Base::natural_vector_size;
+    template<typename T2>
+    using Input = typename Base::template Input<T2>;
+    template<typename T2>
+    using Output = typename Base::template Output<T2>;
+
+    GeneratorParam<Layout> layout_{"layout", Layout::Planar, layout_names};
+    GeneratorParam<int> strip_rows_{"strip_rows", 32};
+    GeneratorParam<int> window_{"window", 3};
+    GeneratorParam<ResponseMode> response_{"response", ResponseMode::Harris, response_names};
+    GeneratorParam<Boundary> boundary_{"boundary", Boundary::None, boundary_names};
 
-        Func trace("trace");
-        trace(x, y) = Sxx(x, y) + Syy(x, y);
+    Input<Buffer<TIn>> input{"input", 3};
+    Input<double> k{"k"};
+    Output<Buffer<TOut>> output{"output", 2};
+
+    void generate() {
+        Var x("x"), y("y");
 
-        output(x, y) = det(x, y) - 0.04f * trace(x, y) * trace(x, y);
+        const Layout layout = layout_;
+        constrain_layout(input, layout);
+
+        user_assert(window_ >= 3 && window_ % 2 == 1)
+            << "The summation window has to be odd and at least 3 wide\n";
+
+        ResponseParams params;
+        params.k = k;
+        params.window = window_;
+        params.mode = response_;
+
+        const Boundary boundary = boundary_;
+        Func bounded("bounded");
+        if (boundary == Boundary::RepeatEdge) {
+            bounded = BoundaryConditions::repeat_edge(input);
+        } else if (boundary == Boundary::Constant) {
+            bounded = BoundaryConditions::constant_exterior(input, cast<TIn>(0));
+        }
+
+        HarrisStages stages = define_harris(
+            [&](Expr xe, Expr ye, Expr ce) {
+                if (boundary == Boundary::None) {
+                    return cast<TMath>(input(xe, ye, ce));
+                }
+                return cast<TMath>(bounded(xe, ye, ce));
+            },
+            x, y, layout, {}, params);
+        Func gray = stages.gray;
+        Func Ix = stages.Ix;
+        Func Iy = stages.Iy;
+
+        output(x, y) = cast<TOut>(stages.response(x, y));
 
         // Estimates (for autoscheduler; ignored otherwise)
         {
             const int kWidth = 1536;
             const int kHeight = 2560;
+            const int halo = response_halo(window_);
             input.dim(0).set_estimate(0, kWidth);
             input.dim(1).set_estimate(0, kHeight);
-            input.dim(2).set_estimate(0, 3);
-            output.dim(0).set_estimate(3, kWidth - 6);
-            output.dim(1).set_estimate(3, kHeight - 6);
+            input.dim(2).set_estimate(0, layout == Layout::Gray ? 1 : 3);
+            k.set_estimate(0.04);
+            output.dim(0).set_estimate(halo, kWidth - 2 * halo);
+            output.dim(1).set_estimate(halo, kHeight - 2 * halo);
         }
 
         // Schedule
-        if (!auto_schedule) {
+        if (!auto_schedule && boundary != Boundary::None) {
+            // The bands along the edges are only a few pixels wide or high,
+            // rows are computed independently to avoid redundant work for
+            // the (mostly clamped) neighborhoods of a full strip.
+            Var xi("xi"), yi("yi");
+            if (get_target().has_gpu_feature()) {
+                output.gpu_tile(x, y, xi, yi, 32, 4);
+            } else {
+                const int vec = natural_vector_size(type_of<TMath>());
+                output.parallel(y)
+                    .vectorize(x, vec, TailStrategy::GuardWithIf);
+                if (layout != Layout::Gray) {
+                    gray.compute_at(output, y)
+                        .vectorize(x, vec, TailStrategy::GuardWithIf);
+                }
+                Ix.compute_at(output, y)
+                    .vectorize(x, vec, TailStrategy::GuardWithIf);
+                Iy.compute_at(output, y)
+                    .vectorize(x, vec, TailStrategy::GuardWithIf);
+                for (Func row : stages.row_sums) {
+                    row.compute_at(output, y)
+                        .vectorize(x, vec, TailStrategy::GuardWithIf);
+                }
+            }
+        } else if (!auto_schedule) {
             Var xi("xi"), yi("yi");
             if (get_target().has_gpu_feature()) {
                 // 0.253ms on a 2060 RTX
                 output.gpu_tile(x, y, xi, yi, 62, 14)
                     .unroll(xi, 2);
-                gray.compute_at(output, x)
-                    .gpu_threads(x, y)
-                    .tile(x, y, xi, yi, 3, 2)
-                    .unroll(xi)
-                    .unroll(yi);
-                gray.in()
-                    .compute_at(Iy, x)
-                    .vectorize(x, 2)
-                    .unroll(x)
-                    .unroll(y);
+                if (layout != Layout::Gray) {
+                    gray.compute_at(output, x)
+                        .gpu_threads(x, y)
+                        .tile(x, y, xi, yi, 3, 2)
+                        .unroll(xi)
+                        .unroll(yi);
+                    gray.in()
+                        .compute_at(Iy, x)
+                        .vectorize(x, 2)
+                        .unroll(x)
+                        .unroll(y);
+                }
                 Ix.compute_at(output, x)
                     .gpu_threads(x, y)
                     .unroll(x, 2);
@@ -106,14 +342,16 @@ public:
                     .unroll(x)
                     .unroll(y);
             } else {
-                // 0.92ms on an Intel i9-9960X using 16 threads
-                const int vec = natural_vector_size<double>();
-                output.split(y, y, yi, 32)
+                // 0.92ms on an Intel i9-9960X using 16 threads (double)
+                const int vec = natural_vector_size(type_of<TMath>());
+                output.split(y, y, yi, strip_rows_)
                     .parallel(y)
                     .vectorize(x, vec);
-                gray.store_at(output, y)
-                    .compute_at(output, yi)
-                    .vectorize(x, vec);
+                if (layout != Layout::Gray) {
+                    gray.store_at(output, y)
+                        .compute_at(output, yi)
+                        .vectorize(x, vec);
+                }
                 Ix.store_at(output, y)
                     .compute_at(output, yi)
                     .vectorize(x, vec);
@@ -121,11 +359,180 @@ public:
                     .compute_at(output, yi)
                     .vectorize(x, vec);
                 Ix.compute_with(Iy, x);
+                for (Func row : stages.row_sums) {
+                    row.store_at(output, y)
+                        .compute_at(output, yi)
+                        .vectorize(x, vec);
+                }
+
+                specialize_layout(output, input, layout);
             }
         }
     }
 };
 
+// Harris corner response for a stack of frames, the frames are processed by
+// a single pipeline invocation.
+class HarrisBatch : public Halide::Generator<HarrisBatch> {
+public:
+    GeneratorParam<Layout> layout_{"layout", Layout::Planar, layout_names};
+
+    Input<Buffer<double>> input{"input", 4};
+    Output<Buffer<double>> output{"output", 3};
+
+    void generate() {
+        Var x("x"), y("y"), n("n");
+
+        const Layout layout = layout_;
+        constrain_layout(input, layout);
+
+        HarrisStages stages = define_harris(
+            [&](Expr xe, Expr ye, Expr ce) { return input(xe, ye, ce, n); },
+            x, y, layout, {n});
+        Func gray = stages.gray;
+        Func Ix = stages.Ix;
+        Func Iy = stages.Iy;
+
+        output(x, y, n) = stages.response(x, y, n);
+
+        // Schedule
+        Var xi("xi"), yi("yi"), t("t");
+        if (get_target().has_gpu_feature()) {
+            output.gpu_tile(x, y, xi, yi, 62, 14);
+            if (layout != Layout::Gray) {
+                gray.compute_at(output, x)
+                    .gpu_threads(x, y);
+            }
+            Ix.compute_at(output, x)
+                .gpu_threads(x, y);
+            Iy.compute_at(output, x)
+                .gpu_threads(x, y);
+            Ix.compute_with(Iy, x);
+        } else {
+            // Parallelize over the strips of all frames together, small
+            // frames would not have enough strips to keep all cores busy.
+            const int vec = natural_vector_size<double>();
+            output.split(y, y, yi, 32)
+                .fuse(y, n, t)
+                .parallel(t)
+                .vectorize(x, vec);
+            if (layout != Layout::Gray) {
+                gray.store_at(output, t)
+                    .compute_at(output, yi)
+                    .vectorize(x, vec);
+            }
+            Ix.store_at(output, t)
+                .compute_at(output, yi)
+                .vectorize(x, vec);
+            Iy.store_at(output, t)
+                .compute_at(output, yi)
+                .vectorize(x, vec);
+            Ix.compute_with(Iy, x);
+
+            specialize_layout(output, input, layout);
+        }
+    }
+};
+
+// Harris corner response followed by thresholding and non-maximum
+// suppression over a nms_size x nms_size neighborhood. All pixels that are
+// not a local maximum above the threshold are set to zero. Compared to the
+// plain response, the output shrinks by nms_size / 2 more pixels per side.
+class HarrisCorners : public Halide::Generator<HarrisCorners> {
+public:
+    GeneratorParam<Layout> layout_{"layout", Layout::Planar, layout_names};
+    GeneratorParam<int> nms_size_{"nms_size", 3};
+
+    Input<Buffer<double>> input{"input", 3};
+    Input<double> threshold{"threshold"};
+    Output<Buffer<double>> output{"output", 2};
+
+    void generate() {
+        Var x("x"), y("y");
+
+        const Layout layout = layout_;
+        constrain_layout(input, layout);
+
+        HarrisStages stages = define_harris(
+            [&](Expr xe, Expr ye, Expr ce) { return input(xe, ye, ce); },
+            x, y, layout);
+        Func gray = stages.gray;
+        Func Ix = stages.Ix;
+        Func Iy = stages.Iy;
+        Func response = stages.response;
+
+        // separable maximum over the suppression window
+        const int radius = nms_size_ / 2;
+        RDom k(-radius, 2 * radius + 1, "k");
+
+        Func max_x("max_x");
+        max_x(x, y) = maximum(response(x + k, y));
+
+        Func local_max("local_max");
+        local_max(x, y) = maximum(max_x(x, y + k));
+
+        output(x, y) = select(response(x, y) >= threshold &&
+                                  response(x, y) >= local_max(x, y),
+                              response(x, y), cast<double>(0));
+
+        // Schedule
+        Var xi("xi"), yi("yi");
+        if (get_target().has_gpu_feature()) {
+            output.gpu_tile(x, y, xi, yi, 32, 8);
+            response.compute_at(output, x)
+                .gpu_threads(x, y);
+            Ix.compute_at(output, x)
+                .gpu_threads(x, y);
+            Iy.compute_at(output, x)
+                .gpu_threads(x, y);
+            Ix.compute_with(Iy, x);
+        } else {
+            // All intermediate rows slide down the strips, the suppressed
+            // response is the only full size buffer written.
+            const int vec = natural_vector_size<double>();
+            output.split(y, y, yi, 32)
+                .parallel(y)
+                .vectorize(x, vec);
+            max_x.store_at(output, y)
+                .compute_at(output, yi)
+                .vectorize(x, vec);
+            response.store_at(output, y)
+                .compute_at(output, yi)
+                .vectorize(x, vec);
+            if (layout != Layout::Gray) {
+                gray.store_at(output, y)
+                    .compute_at(output, yi)
+                    .vectorize(x, vec);
+            }
+            Ix.store_at(output, y)
+                .compute_at(output, yi)
+                .vectorize(x, vec);
+            Iy.store_at(output, y)
+                .compute_at(output, yi)
+                .vectorize(x, vec);
+            Ix.compute_with(Iy, x);
+
+            specialize_layout(output, input, layout);
+        }
+    }
+};
+
+// HALIDE_REGISTER_GENERATOR is a macro, the commas of a template argument
+// list would split its arguments.
+using HarrisF64 = Harris<double, double, double>;
+using HarrisU8 = Harris<uint8_t, float, double>;
+// int64 pixels are as wide as double ones, so this does not save input
+// bandwidth over harris. It lets Phylanx integer images be filtered without
+// first converting them into a double copy of the whole image, and keeps the
+// intermediates in float32.
+using HarrisI64 = Harris<int64_t, float, double>;
+using HarrisF32 = Harris<float, float, float>;
+
 }  // namespace
 
-HALIDE_REGISTER_GENERATOR(Harris, harris)
+HALIDE_REGISTER_GENERATOR(HarrisF64, harris)
+HALIDE_REGISTER_GENERATOR(HarrisU8, harris_u8)
+HALIDE_REGISTER_GENERATOR(HarrisI64, harris_i64)
+HALIDE_REGISTER_GENERATOR(HarrisF32, harris_f32)
+HALIDE_REGISTER_GENERATOR(HarrisBatch, harris_batch)
+HALIDE_REGISTER_GENERATOR(HarrisCorners, harris_corners)